@@ -0,0 +1,455 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Internal/SimpleObjects.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A monotonic buffer, which hands out memory from a few large blocks,
+ *        and releases all of them together when it's destroyed; memory given
+ *        out is never reused before that.
+ *        NOTE: it's not thread-safe
+ *
+ */
+class Arena
+{
+public: // static members:
+
+	static constexpr size_t sk_defaultBlockSize = 64 * 1024;
+	static constexpr size_t sk_align = alignof(std::max_align_t);
+
+public:
+
+	explicit Arena(size_t blockSize = sk_defaultBlockSize) :
+		m_blockSize(blockSize),
+		m_blocks(),
+		m_ptr(nullptr),
+		m_left(0),
+		m_usedSize(0)
+	{}
+
+	Arena(const Arena& other) = delete;
+
+	~Arena() = default;
+
+	Arena& operator=(const Arena& other) = delete;
+
+	/**
+	 * @brief Allocate `size` bytes, aligned to `sk_align`
+	 *
+	 */
+	void* Allocate(size_t size)
+	{
+		size = ((size + sk_align - 1) / sk_align) * sk_align;
+		m_usedSize += size;
+
+		if (size > m_left)
+		{
+			// large requests get their own block, so the space left in the
+			// current block isn't wasted
+			if (size > (m_blockSize / 4))
+			{
+				return AddBlock(size);
+			}
+
+			m_ptr = AddBlock(m_blockSize);
+			m_left = m_blockSize;
+		}
+
+		void* res = m_ptr;
+		m_ptr += size;
+		m_left -= size;
+		return res;
+	}
+
+	/**
+	 * @brief Get the number of blocks allocated so far
+	 *
+	 */
+	size_t GetBlockCount() const
+	{
+		return m_blocks.size();
+	}
+
+	/**
+	 * @brief Get the number of bytes given out so far
+	 *
+	 */
+	size_t GetUsedSize() const
+	{
+		return m_usedSize;
+	}
+
+private:
+
+	char* AddBlock(size_t size)
+	{
+		std::unique_ptr<char[]> block(new char[size]);
+		m_blocks.push_back(std::move(block));
+		return m_blocks.back().get();
+	}
+
+	size_t m_blockSize;
+	std::vector<std::unique_ptr<char[]> > m_blocks;
+	char* m_ptr;
+	size_t m_left;
+	size_t m_usedSize;
+
+}; // class Arena
+
+namespace Internal
+{
+
+inline Arena*& CurrentArena()
+{
+	static thread_local Arena* s_arena = nullptr;
+	return s_arena;
+}
+
+/**
+ * @brief The header placed in front of each arena node, which records where
+ *        the node comes from, so it can be deallocated correctly
+ *
+ */
+union ArenaNodeHeader
+{
+	Arena* m_arena;
+	std::max_align_t m_align;
+}; // union ArenaNodeHeader
+
+inline void* ArenaNodeAllocate(size_t size)
+{
+	Arena* arena = CurrentArena();
+	void* ptr = (arena != nullptr) ?
+		arena->Allocate(sizeof(ArenaNodeHeader) + size) :
+		::operator new(sizeof(ArenaNodeHeader) + size);
+
+	ArenaNodeHeader* header = static_cast<ArenaNodeHeader*>(ptr);
+	header->m_arena = arena;
+	return header + 1;
+}
+
+inline void ArenaNodeDeallocate(void* ptr) noexcept
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	ArenaNodeHeader* header = static_cast<ArenaNodeHeader*>(ptr) - 1;
+	if (header->m_arena == nullptr)
+	{
+		::operator delete(header);
+	}
+	// otherwise, the memory is released together with the arena
+}
+
+/**
+ * @brief Make arena nodes allocated by the current thread come from the
+ *        given arena, until the scope ends.
+ *        NOTE: it's only meant for parsing a document (see
+ *        `ArenaDocumentImpl`), since arena nodes cloned in the scope are
+ *        *moved* out of their source, which is assumed to be a temporary
+ *        of the parser
+ *
+ */
+class ArenaScope
+{
+public:
+
+	explicit ArenaScope(Arena& arena) :
+		m_prevArena(CurrentArena())
+	{
+		CurrentArena() = &arena;
+	}
+
+	ArenaScope(const ArenaScope& other) = delete;
+
+	~ArenaScope()
+	{
+		CurrentArena() = m_prevArena;
+	}
+
+	ArenaScope& operator=(const ArenaScope& other) = delete;
+
+private:
+
+	Arena* m_prevArena;
+
+}; // class ArenaScope
+
+} // namespace Internal
+
+/**
+ * @brief A node type (e.g., `String`) whose storage comes from the arena
+ *        of the current `Internal::ArenaScope`, or from the heap if there is
+ *        none.
+ *        Nodes are placed in the arena when they are cloned into the generic
+ *        object holders (i.e., `Object`), so all nodes of a document parsed
+ *        in the scope are in the arena; in the scope, the clone moves the
+ *        content out of the parser's temporary node, so each node is built
+ *        once, rather than being copied (deeply, for lists and dicts).
+ *        NOTE: only the storage of the node itself is in the arena, while
+ *        the memory managed by the node (e.g., characters of a long string,
+ *        or items of a list) still comes from the node's own allocator;
+ *        see `ArenaDocumentImpl` for the share of allocations in the arena
+ *
+ * @tparam _BaseType The node type from SimpleObjects
+ */
+template<typename _BaseType, typename _ToStringType>
+class ArenaNodeImpl : public _BaseType
+{
+public: // static members:
+
+	using Base = _BaseType;
+	using BaseObjType = Internal::Obj::BaseObject<_ToStringType>;
+
+	static void* operator new(size_t size)
+	{
+		return Internal::ArenaNodeAllocate(size);
+	}
+
+	static void operator delete(void* ptr) noexcept
+	{
+		Internal::ArenaNodeDeallocate(ptr);
+	}
+
+public:
+
+	using Base::Base;
+
+	ArenaNodeImpl() = default;
+
+	ArenaNodeImpl(const ArenaNodeImpl& other) = default;
+
+	ArenaNodeImpl(ArenaNodeImpl&& other) = default;
+
+	ArenaNodeImpl(const Base& other) :
+		Base(other)
+	{}
+
+	ArenaNodeImpl(Base&& other) :
+		Base(std::move(other))
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~ArenaNodeImpl() = default;
+	// LCOV_EXCL_STOP
+
+	ArenaNodeImpl& operator=(const ArenaNodeImpl& other) = default;
+
+	ArenaNodeImpl& operator=(ArenaNodeImpl&& other) = default;
+
+	virtual std::unique_ptr<BaseObjType> CloneBase() const override
+	{
+		return std::unique_ptr<BaseObjType>(CloneNode());
+	}
+
+private:
+
+	ArenaNodeImpl* CloneNode() const
+	{
+		if (Internal::CurrentArena() != nullptr)
+		{
+			// the node is a temporary of the parser (see
+			// `Internal::ArenaScope`), which is not const by itself
+			return new ArenaNodeImpl(
+				std::move(const_cast<ArenaNodeImpl&>(*this)));
+		}
+		return new ArenaNodeImpl(*this);
+	}
+
+}; // class ArenaNodeImpl
+
+/**
+ * @brief Same as `ArenaNodeImpl`, but for hashable node types, which can
+ *        also be cloned into the hashable object holders (i.e.,
+ *        `HashableObject`)
+ *
+ */
+template<typename _BaseType, typename _ToStringType>
+class ArenaHashableNodeImpl : public _BaseType
+{
+public: // static members:
+
+	using Base = _BaseType;
+	using BaseObjType = Internal::Obj::BaseObject<_ToStringType>;
+	using HashableBaseObjType =
+		Internal::Obj::HashableBaseObject<_ToStringType>;
+
+	static void* operator new(size_t size)
+	{
+		return Internal::ArenaNodeAllocate(size);
+	}
+
+	static void operator delete(void* ptr) noexcept
+	{
+		Internal::ArenaNodeDeallocate(ptr);
+	}
+
+public:
+
+	using Base::Base;
+
+	ArenaHashableNodeImpl() = default;
+
+	ArenaHashableNodeImpl(const ArenaHashableNodeImpl& other) = default;
+
+	ArenaHashableNodeImpl(ArenaHashableNodeImpl&& other) = default;
+
+	ArenaHashableNodeImpl(const Base& other) :
+		Base(other)
+	{}
+
+	ArenaHashableNodeImpl(Base&& other) :
+		Base(std::move(other))
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~ArenaHashableNodeImpl() = default;
+	// LCOV_EXCL_STOP
+
+	ArenaHashableNodeImpl& operator=(
+		const ArenaHashableNodeImpl& other) = default;
+
+	ArenaHashableNodeImpl& operator=(ArenaHashableNodeImpl&& other) = default;
+
+	virtual std::unique_ptr<BaseObjType> CloneBase() const override
+	{
+		return std::unique_ptr<BaseObjType>(CloneNode());
+	}
+
+	virtual std::unique_ptr<HashableBaseObjType> CloneHashable() const override
+	{
+		return std::unique_ptr<HashableBaseObjType>(CloneNode());
+	}
+
+private:
+
+	ArenaHashableNodeImpl* CloneNode() const
+	{
+		if (Internal::CurrentArena() != nullptr)
+		{
+			// the node is a temporary of the parser (see
+			// `Internal::ArenaScope`), which is not const by itself
+			return new ArenaHashableNodeImpl(
+				std::move(const_cast<ArenaHashableNodeImpl&>(*this)));
+		}
+		return new ArenaHashableNodeImpl(*this);
+	}
+
+}; // class ArenaHashableNodeImpl
+
+/**
+ * @brief Select `ArenaHashableNodeImpl` for hashable node types, or
+ *        `ArenaNodeImpl` for the others
+ *
+ */
+template<typename _BaseType, typename _ToStringType>
+using ArenaNodeT = typename std::conditional<
+	std::is_base_of<
+		Internal::Obj::HashableBaseObject<_ToStringType>, _BaseType>::value,
+	ArenaHashableNodeImpl<_BaseType, _ToStringType>,
+	ArenaNodeImpl<_BaseType, _ToStringType> >::type;
+
+/**
+ * @brief A parsed document, which owns both the arena and the root of the
+ *        document, so the nodes are always destroyed before the arena.
+ *        Only the nodes themselves (i.e., one allocation per JSON value)
+ *        come from the arena; the memory owned by the nodes still comes
+ *        from the heap, which is:
+ *        - one allocation per string that doesn't fit in the inline buffer
+ *          of the string type
+ *        - the allocations of the item container of each list and dict
+ *          (e.g., one per growth of a vector, or one per entry plus the
+ *          buckets of a hash map)
+ *        So the arena takes all allocations of documents made of numbers,
+ *        literals and short strings, and fewer of those dominated by long
+ *        strings or large containers.
+ *        NOTE: the root is only given out as const, so no node can be moved
+ *        out of the arena; copies of the nodes are allocated from the heap
+ *
+ * @tparam _ObjType The type of the root (e.g., `Object`)
+ */
+template<typename _ObjType>
+class ArenaDocumentImpl
+{
+public: // static members:
+
+	using ObjType = _ObjType;
+
+	/**
+	 * @brief Parse the input with the given parser, whose nodes must be
+	 *        arena nodes (e.g., `ArenaGenericObjectParser`), into a document
+	 *        with its own arena
+	 *
+	 */
+	template<typename _ParserType, typename _InputType>
+	static ArenaDocumentImpl Parse(
+		const _ParserType& parser,
+		const _InputType& input,
+		size_t blockSize = Arena::sk_defaultBlockSize)
+	{
+		std::unique_ptr<Arena> arena(new Arena(blockSize));
+
+		Internal::ArenaScope scope(*arena);
+		ObjType root = parser.ParseTillEnd(input);
+
+		return ArenaDocumentImpl(std::move(arena), std::move(root));
+	}
+
+public:
+
+	ArenaDocumentImpl(const ArenaDocumentImpl& other) = delete;
+
+	ArenaDocumentImpl(ArenaDocumentImpl&& other) = default;
+
+	// m_root is declared after m_arena, so it's destroyed first
+	~ArenaDocumentImpl() = default;
+
+	ArenaDocumentImpl& operator=(const ArenaDocumentImpl& other) = delete;
+
+	// a member-wise move would release the arena before the root
+	ArenaDocumentImpl& operator=(ArenaDocumentImpl&& other) = delete;
+
+	const ObjType& GetRoot() const
+	{
+		return m_root;
+	}
+
+	const Arena& GetArena() const
+	{
+		return *m_arena;
+	}
+
+private:
+
+	ArenaDocumentImpl(std::unique_ptr<Arena> arena, ObjType root) :
+		m_arena(std::move(arena)),
+		m_root(std::move(root))
+	{}
+
+	std::unique_ptr<Arena> m_arena;
+	ObjType m_root;
+
+}; // class ArenaDocumentImpl
+
+} // namespace SimpleJson
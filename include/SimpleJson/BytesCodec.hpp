@@ -0,0 +1,154 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "BytesEncoding.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+namespace Internal
+{
+
+static constexpr char sk_base64Chars[] =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static constexpr char sk_hexLowerChars[] = "0123456789abcdef";
+
+/**
+ * @brief Encode bytes into base64 characters, three bytes into four
+ *        characters at a time; the last group is padded with `=`
+ *
+ * @param dest must have space for `((len + 2) / 3) * 4` characters
+ * @return the end of the characters written
+ */
+inline char* Base64Encode(char* dest, const uint8_t* src, size_t len)
+{
+	const uint8_t* const end3 = src + (len - (len % 3));
+	for (; src != end3; src += 3)
+	{
+		const uint32_t group =
+			(static_cast<uint32_t>(src[0]) << 16) |
+			(static_cast<uint32_t>(src[1]) << 8) |
+			static_cast<uint32_t>(src[2]);
+		dest[0] = sk_base64Chars[(group >> 18) & 0x3F];
+		dest[1] = sk_base64Chars[(group >> 12) & 0x3F];
+		dest[2] = sk_base64Chars[(group >> 6) & 0x3F];
+		dest[3] = sk_base64Chars[group & 0x3F];
+		dest += 4;
+	}
+
+	switch (len % 3)
+	{
+	case 1:
+	{
+		const uint32_t group = static_cast<uint32_t>(src[0]) << 16;
+		dest[0] = sk_base64Chars[(group >> 18) & 0x3F];
+		dest[1] = sk_base64Chars[(group >> 12) & 0x3F];
+		dest[2] = '=';
+		dest[3] = '=';
+		dest += 4;
+		break;
+	}
+	case 2:
+	{
+		const uint32_t group =
+			(static_cast<uint32_t>(src[0]) << 16) |
+			(static_cast<uint32_t>(src[1]) << 8);
+		dest[0] = sk_base64Chars[(group >> 18) & 0x3F];
+		dest[1] = sk_base64Chars[(group >> 12) & 0x3F];
+		dest[2] = sk_base64Chars[(group >> 6) & 0x3F];
+		dest[3] = '=';
+		dest += 4;
+		break;
+	}
+	default:
+		break;
+	}
+
+	return dest;
+}
+
+/**
+ * @brief Encode bytes into lower-case hexadecimal digits
+ *
+ * @param dest must have space for `len * 2` characters
+ * @return the end of the characters written
+ */
+inline char* HexEncode(char* dest, const uint8_t* src, size_t len)
+{
+	for (const uint8_t* const end = src + len; src != end; ++src)
+	{
+		*dest++ = sk_hexLowerChars[(*src) >> 4];
+		*dest++ = sk_hexLowerChars[(*src) & 0x0F];
+	}
+	return dest;
+}
+
+/**
+ * @brief Decode a base64 character
+ *
+ * @return the 6-bit value, or -1 if it's not a base64 character
+ */
+template<typename _CharType>
+inline int Base64DecodeChar(_CharType ch)
+{
+	if ('A' <= ch && ch <= 'Z')
+	{
+		return static_cast<int>(ch - 'A');
+	}
+	if ('a' <= ch && ch <= 'z')
+	{
+		return static_cast<int>(ch - 'a') + 26;
+	}
+	if ('0' <= ch && ch <= '9')
+	{
+		return static_cast<int>(ch - '0') + 52;
+	}
+	if (ch == '+')
+	{
+		return 62;
+	}
+	if (ch == '/')
+	{
+		return 63;
+	}
+	return -1;
+}
+
+/**
+ * @brief Decode a hexadecimal digit, in either case
+ *
+ * @return the 4-bit value, or -1 if it's not a hexadecimal digit
+ */
+template<typename _CharType>
+inline int HexDecodeChar(_CharType ch)
+{
+	if ('0' <= ch && ch <= '9')
+	{
+		return static_cast<int>(ch - '0');
+	}
+	if ('a' <= ch && ch <= 'f')
+	{
+		return static_cast<int>(ch - 'a') + 10;
+	}
+	if ('A' <= ch && ch <= 'F')
+	{
+		return static_cast<int>(ch - 'A') + 10;
+	}
+	return -1;
+}
+
+} // namespace Internal
+
+} // namespace SimpleJson
@@ -0,0 +1,41 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief How bytes objects are represented in JSON, which has no binary
+ *        type; both encodings produce strings that never need escaping
+ *
+ */
+enum class BytesEncoding
+{
+	/**
+	 * @brief Bytes objects can't be serialized
+	 *
+	 */
+	None,
+
+	/**
+	 * @brief Standard base64 (RFC 4648, Section 4), with padding
+	 *
+	 */
+	Base64,
+
+	/**
+	 * @brief Lower-case hexadecimal digits, two for each byte
+	 *
+	 */
+	Hex,
+}; // enum class BytesEncoding
+
+} // namespace SimpleJson
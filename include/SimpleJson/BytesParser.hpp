@@ -0,0 +1,189 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstdint>
+
+#include "BytesCodec.hpp"
+#include "ParserBase.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief Parser for Bytes type object, which is represented by a JSON string
+ *        in base64 or hexadecimal encoding.
+ *        Characters are decoded as they are read from the input, straight
+ *        into the bytes object, so the string is never stored.
+ *        The only escape accepted is `\/`, which some writers use for `/`.
+ *
+ * @tparam _ContainerType Type of containers which *may* be needed during
+ *                        intermediate steps.
+ *                        Meanwhile, the input character type is inferred by
+ *                        `_ContainerType::value_type`
+ * @tparam _ObjType       The type used to construct the parsed object
+ * @tparam _RetType       The type that will be returned by the parser;
+ *                        it's default to the `_ObjType`
+ */
+template<
+	typename _ContainerType,
+	typename _ObjType,
+	typename _RetType = _ObjType>
+class BytesParserImpl : public ParserBase<_ContainerType, _RetType>
+{
+public: // static members:
+
+	using Base = ParserBase<_ContainerType, _RetType>;
+	using Self = BytesParserImpl<_ContainerType, _ObjType, _RetType>;
+
+	using ContainerType = _ContainerType;
+	using InputChType   = typename ContainerType::value_type;
+	using ObjType       = _ObjType;
+	using RetType       = _RetType;
+	using IteratorType  = Internal::Obj::FrIterator<InputChType, true>;
+	using ISMType       = ForwardIteratorStateMachine<IteratorType>;
+
+public:
+
+	/**
+	 * @param encoding the encoding of the string; `BytesEncoding::None` is
+	 *                 treated as `BytesEncoding::Base64`
+	 */
+	explicit BytesParserImpl(BytesEncoding encoding = BytesEncoding::Base64) :
+		Base(),
+		m_encoding(encoding)
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~BytesParserImpl() = default;
+	// LCOV_EXCL_STOP
+
+	using Base::Parse;
+
+	virtual RetType Parse(InputStateMachineIf<InputChType>& ism) const override
+	{
+		return Parse2Obj(ism);
+	}
+
+protected:
+
+	ObjType Parse2Obj(InputStateMachineIf<InputChType>& ism) const
+	{
+		auto ch = ism.SkipSpaceAndGetCharAndAdv();
+		if (ch != '\"')
+		{
+			throw ParseError("Unexpected character",
+				ism.GetLineCount(), ism.GetColCount());
+		}
+
+		return m_encoding == BytesEncoding::Hex ?
+			ParseHex(ism) : ParseBase64(ism);
+	}
+
+private:
+
+	/**
+	 * @brief Read the next character of the string
+	 *
+	 * @return the character, or `"` at the end of the string
+	 */
+	static InputChType ReadChar(InputStateMachineIf<InputChType>& ism)
+	{
+		auto ch = ism.GetCharAndAdv();
+		if (ch == '\\')
+		{
+			ch = ism.GetCharAndAdv();
+			if (ch != '/')
+			{
+				throw ParseError("Unexpected escape in encoded bytes",
+					ism.GetLineCount(), ism.GetColCount());
+			}
+		}
+		return ch;
+	}
+
+	static ObjType ParseBase64(InputStateMachineIf<InputChType>& ism)
+	{
+		auto res = ObjType();
+
+		uint32_t group = 0;
+		size_t groupLen = 0;
+		auto ch = ReadChar(ism);
+		for (; ch != '\"' && ch != '='; ch = ReadChar(ism))
+		{
+			const int val = Internal::Base64DecodeChar(ch);
+			if (val < 0)
+			{
+				throw ParseError("Invalid base64 character",
+					ism.GetLineCount(), ism.GetColCount());
+			}
+
+			group = (group << 6) | static_cast<uint32_t>(val);
+			if (++groupLen == 4)
+			{
+				res.push_back(static_cast<uint8_t>(group >> 16));
+				res.push_back(static_cast<uint8_t>(group >> 8));
+				res.push_back(static_cast<uint8_t>(group));
+				group = 0;
+				groupLen = 0;
+			}
+		}
+
+		// the last group must be padded to 4 characters
+		size_t padLen = 0;
+		for (; ch == '='; ch = ReadChar(ism))
+		{
+			++padLen;
+		}
+		if (ch != '\"' ||
+			groupLen == 1 ||
+			padLen != (4 - groupLen) % 4)
+		{
+			throw ParseError("Invalid base64 padding",
+				ism.GetLineCount(), ism.GetColCount());
+		}
+
+		if (groupLen == 2)
+		{
+			res.push_back(static_cast<uint8_t>(group >> 4));
+		}
+		else if (groupLen == 3)
+		{
+			res.push_back(static_cast<uint8_t>(group >> 10));
+			res.push_back(static_cast<uint8_t>(group >> 2));
+		}
+
+		return res;
+	}
+
+	static ObjType ParseHex(InputStateMachineIf<InputChType>& ism)
+	{
+		auto res = ObjType();
+
+		for (auto ch = ReadChar(ism); ch != '\"'; ch = ReadChar(ism))
+		{
+			const int high = Internal::HexDecodeChar(ch);
+			const int low = Internal::HexDecodeChar(ReadChar(ism));
+			if (high < 0 || low < 0)
+			{
+				throw ParseError("Invalid hexadecimal digit",
+					ism.GetLineCount(), ism.GetColCount());
+			}
+			res.push_back(static_cast<uint8_t>((high << 4) | low));
+		}
+
+		return res;
+	}
+
+	BytesEncoding m_encoding;
+
+}; // class BytesParserImpl
+
+} // namespace SimpleJson
@@ -0,0 +1,92 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstdint>
+
+#include "BytesCodec.hpp"
+#include "Exceptions.hpp"
+#include "Utils.hpp"
+#include "WriterConfig.hpp"
+#include "Internal/SimpleObjects.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief Writer for bytes objects, which are written as JSON strings in the
+ *        encoding selected by `WriterConfig::m_bytesEncoding`.
+ *        Bytes are encoded block by block into a buffer on the stack, and
+ *        each block is written in bulk, so no temporary string is needed
+ *        no matter how large the bytes are.
+ *
+ * @exception SerializeTypeError thrown if `m_bytesEncoding` is `None`
+ */
+template<typename _ToStringType>
+struct JsonWriterBytesImpl
+{
+	/**
+	 * @brief The number of characters encoded in each block
+	 *
+	 */
+	static constexpr size_t sk_blockSize = 256;
+
+	template<typename _OutputIt>
+	inline static void Write(_OutputIt destIt,
+		const Internal::Obj::BytesBaseObject<_ToStringType>& obj,
+		const WriterConfig& config,
+		const WriterStates&)
+	{
+		switch (config.m_bytesEncoding)
+		{
+		case BytesEncoding::Base64:
+			// every 3 bytes are encoded into 4 characters
+			return WriteEncoded(destIt, obj.data(), obj.size(),
+				(sk_blockSize / 4) * 3, Internal::Base64Encode);
+
+		case BytesEncoding::Hex:
+			// every byte is encoded into 2 characters
+			return WriteEncoded(destIt, obj.data(), obj.size(),
+				sk_blockSize / 2, Internal::HexEncode);
+
+		default:
+			throw SerializeTypeError(obj.GetCategoryName());
+		}
+	}
+
+private:
+
+	template<typename _OutputIt, typename _EncodeFunc>
+	inline static void WriteEncoded(_OutputIt destIt,
+		const uint8_t* data, size_t size,
+		size_t bytesPerBlock,
+		_EncodeFunc encode)
+	{
+		char buf[sk_blockSize];
+
+		*destIt++ = '\"';
+		while (size > 0)
+		{
+			const size_t len = size < bytesPerBlock ? size : bytesPerBlock;
+			const char* end = encode(buf, data, len);
+			Internal::WriteChars(destIt, buf, static_cast<size_t>(end - buf));
+
+			data += len;
+			size -= len;
+		}
+		*destIt++ = '\"';
+	}
+
+}; // struct JsonWriterBytesImpl
+
+template<typename _ToStringType>
+constexpr size_t JsonWriterBytesImpl<_ToStringType>::sk_blockSize;
+
+} // namespace SimpleJson
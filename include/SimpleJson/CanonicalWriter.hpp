@@ -0,0 +1,295 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "DictWriter.hpp"
+#include "NumFormatter.hpp"
+#include "Utils.hpp"
+#include "WriterConfig.hpp"
+#include "Internal/SimpleObjects.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief Writer that produces the canonical form defined by RFC 8785
+ *        (JSON Canonicalization Scheme), so the output is deterministic
+ *        regardless of the dict implementation, and can be hashed or
+ *        signed:
+ *        - no whitespace
+ *        - dict keys are sorted by their UTF-16 code units
+ *        - strings are written as UTF-8, and only '"', '\\', and control
+ *          characters are escaped
+ *        - numbers are written as ECMAScript does; integers beyond
+ *          +/-2^53 are converted to `double` first, since JCS only deals with
+ *          IEEE 754 doubles
+ *        Settings in `WriterConfig` are ignored, since the format is fixed.
+ *
+ * @exception SerializeTypeError  thrown if a dict key is not a string, or
+ *                                the type can't be serialized
+ * @exception SerializeValueError thrown if a string is not a valid UTF-8
+ *                                string, or a number is NaN or infinity
+ *
+ * @tparam _StrWriter The string writer, which provides `WriteRawUnicode`
+ */
+template<typename _StrWriter, typename _ToStringType>
+struct JsonWriterCanonicalImpl
+{
+
+	using StrWriter = _StrWriter;
+	using ObjType   = Internal::Obj::BaseObject<_ToStringType>;
+	using ListBase  = typename ObjType::ListBase;
+
+	/**
+	 * @brief A reference to an item in a dict, so the items can be sorted
+	 *        without copying the keys
+	 *
+	 */
+	struct DictItemRef
+	{
+		const char* m_key;
+		size_t m_keyLen;
+		const ObjType* m_val;
+	}; // struct DictItemRef
+
+	/**
+	 * @brief Compare two UTF-8 keys by their UTF-16 code units, without
+	 *        converting them.
+	 *        The order of UTF-8 bytes is the order of code points, which only
+	 *        differs from the order of UTF-16 code units when a character in
+	 *        U+E000..U+FFFF (lead byte 0xEE or 0xEF) meets a supplementary
+	 *        character (lead byte 0xF0..0xF4), which becomes surrogates,
+	 *        U+D800..U+DFFF, in UTF-16
+	 *
+	 */
+	inline static bool KeyLess(const DictItemRef& a, const DictItemRef& b)
+	{
+		const uint8_t* pa = reinterpret_cast<const uint8_t*>(a.m_key);
+		const uint8_t* pb = reinterpret_cast<const uint8_t*>(b.m_key);
+		const size_t minLen = std::min(a.m_keyLen, b.m_keyLen);
+
+		const auto diff = std::mismatch(pa, pa + minLen, pb);
+		if (diff.first == pa + minLen)
+		{
+			return a.m_keyLen < b.m_keyLen;
+		}
+
+		const uint8_t ca = *diff.first;
+		const uint8_t cb = *diff.second;
+		if (ca >= 0xF0 && (cb == 0xEE || cb == 0xEF))
+		{
+			return true;
+		}
+		if (cb >= 0xF0 && (ca == 0xEE || ca == 0xEF))
+		{
+			return false;
+		}
+		return ca < cb;
+	}
+
+	template<typename _OutputIt>
+	inline static void WriteStr(_OutputIt destIt,
+		const char* str, size_t len)
+	{
+		*destIt++ = '\"';
+		StrWriter::WriteRawUnicode(destIt, str, str + len, true);
+		*destIt++ = '\"';
+	}
+
+	template<typename _OutputIt>
+	inline static void WriteDouble(_OutputIt destIt, double val)
+	{
+		if (!std::isfinite(val))
+		{
+			throw SerializeValueError("NaN or infinity");
+		}
+
+		char buf[Internal::sk_ecmaFormatBufSize];
+		const char* end = Internal::FormatEcmaNumber(buf, val);
+		Internal::WriteChars(destIt, buf, static_cast<size_t>(end - buf));
+	}
+
+	template<typename _OutputIt>
+	inline static void WriteNum(_OutputIt destIt,
+		const Internal::Obj::RealNumBaseObject<_ToStringType>& obj)
+	{
+		// integers within this range are exact in double
+		constexpr int64_t maxExactInt = (int64_t(1) << 53);
+
+		char buf[Internal::sk_intFormatBufSize];
+		const char* end = buf;
+
+		switch (obj.GetNumType())
+		{
+		case Internal::Obj::RealNumType::Bool:
+			if (obj.IsTrue())
+			{
+				Internal::WriteChars(destIt, "true", 4);
+			}
+			else
+			{
+				Internal::WriteChars(destIt, "false", 5);
+			}
+			return;
+
+		case Internal::Obj::RealNumType::Int8:
+		case Internal::Obj::RealNumType::Int16:
+		case Internal::Obj::RealNumType::Int32:
+		case Internal::Obj::RealNumType::Int64:
+		{
+			const int64_t val = obj.AsCppInt64();
+			if (val < -maxExactInt || maxExactInt < val)
+			{
+				return WriteDouble(destIt, static_cast<double>(val));
+			}
+			end = Internal::FormatInt(buf, val);
+			break;
+		}
+
+		case Internal::Obj::RealNumType::UInt8:
+		case Internal::Obj::RealNumType::UInt16:
+		case Internal::Obj::RealNumType::UInt32:
+		case Internal::Obj::RealNumType::UInt64:
+		{
+			const uint64_t val = obj.AsCppUInt64();
+			if (static_cast<uint64_t>(maxExactInt) < val)
+			{
+				return WriteDouble(destIt, static_cast<double>(val));
+			}
+			end = Internal::FormatUInt(buf, val);
+			break;
+		}
+
+		default:
+			return WriteDouble(destIt, obj.AsCppDouble());
+		}
+
+		Internal::WriteChars(destIt, buf, static_cast<size_t>(end - buf));
+	}
+
+	/**
+	 * @brief Write a dict in the order of its keys.
+	 *        The references to items are appended to `items`, which is shared
+	 *        by all nesting levels, so the sort buffer is only allocated
+	 *        once; each level only sorts, and then removes, its own part
+	 *
+	 */
+	template<typename _DictTraits, typename _OutputIt>
+	inline static void WriteDict(_OutputIt destIt,
+		const typename _DictTraits::DictBase& obj,
+		std::vector<DictItemRef>& items)
+	{
+		const size_t begin = items.size();
+		for (auto it = obj.cbegin(); it != obj.cend(); ++it)
+		{
+			const auto& key = _DictTraits::GetKey(*it);
+			if (key.GetCategory() != Internal::Obj::ObjCategory::String)
+			{
+				throw SerializeTypeError(key.GetCategoryName());
+			}
+			const auto& keyStr = key.AsString();
+
+			DictItemRef item;
+			item.m_key = keyStr.c_str();
+			item.m_keyLen = keyStr.size();
+			item.m_val = &(_DictTraits::GetVal(*it));
+			items.push_back(item);
+		}
+		const size_t end = items.size();
+		std::sort(items.begin() + begin, items.end(), KeyLess);
+
+		*destIt++ = '{';
+		for (size_t i = begin; i < end; ++i)
+		{
+			if (i != begin)
+			{
+				*destIt++ = ',';
+			}
+
+			// copied, since the buffer may grow in nested levels
+			const DictItemRef item = items[i];
+			WriteStr(destIt, item.m_key, item.m_keyLen);
+			*destIt++ = ':';
+			WriteValue(destIt, *(item.m_val), items);
+		}
+		*destIt++ = '}';
+
+		items.resize(begin);
+	}
+
+	template<typename _OutputIt>
+	inline static void WriteValue(_OutputIt destIt,
+		const ObjType& obj,
+		std::vector<DictItemRef>& items)
+	{
+		switch(obj.GetCategory())
+		{
+		case Internal::Obj::ObjCategory::Null:
+			Internal::WriteChars(destIt, "null", 4);
+			break;
+		case Internal::Obj::ObjCategory::Bool:
+		case Internal::Obj::ObjCategory::Integer:
+		case Internal::Obj::ObjCategory::Real:
+			WriteNum(destIt, obj.AsRealNum());
+			break;
+		case Internal::Obj::ObjCategory::String:
+		{
+			const auto& str = obj.AsString();
+			WriteStr(destIt, str.c_str(), str.size());
+			break;
+		}
+		case Internal::Obj::ObjCategory::List:
+		{
+			const ListBase& list = obj.AsList();
+			*destIt++ = '[';
+			for (auto it = list.cbegin(); it != list.cend(); ++it)
+			{
+				if (it != list.cbegin())
+				{
+					*destIt++ = ',';
+				}
+				WriteValue(destIt, *it, items);
+			}
+			*destIt++ = ']';
+			break;
+		}
+		case Internal::Obj::ObjCategory::Dict:
+			WriteDict<DynamicDictTraits<_ToStringType> >(
+				destIt, obj.AsDict(), items);
+			break;
+		case Internal::Obj::ObjCategory::StaticDict:
+			WriteDict<StaticDictTraits<_ToStringType> >(
+				destIt, obj.AsStaticDict(), items);
+			break;
+		default:
+			throw SerializeTypeError(obj.GetCategoryName());
+		}
+	}
+
+	template<typename _OutputIt>
+	inline static void Write(_OutputIt destIt,
+		const ObjType& obj,
+		const WriterConfig&,
+		const WriterStates&)
+	{
+		std::vector<DictItemRef> items;
+		WriteValue(destIt, obj, items);
+	}
+
+}; // struct JsonWriterCanonicalImpl
+
+} // namespace SimpleJson
@@ -0,0 +1,154 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstdint>
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+namespace Internal
+{
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 UInt128;
+#endif // __SIZEOF_INT128__
+
+} // namespace Internal
+
+/**
+ * @brief The notation of a decimal number in the text it's parsed from, so
+ *        the number can be written back the same way (e.g., `1.5E+03` rather
+ *        than `15e2`)
+ *
+ */
+struct DecimalNotation
+{
+	enum class Form : uint8_t
+	{
+		Auto,  // chosen by the writer, for numbers not parsed from text
+		Plain, // [ minus ] int [ frac ]
+		Exp,   // [ minus ] int [ frac ] exp
+	}; // enum class Form
+
+	DecimalNotation() :
+		DecimalNotation(Form::Auto, 0, 'e', '\0', 0)
+	{}
+
+	/**
+	 * @param form         The form of the number
+	 * @param exp          The value of the exponent as it's written
+	 * @param expCh        The exponent mark, `e` or `E`
+	 * @param expSign      The sign written in front of the exponent, `+`,
+	 *                     `-`, or `\0` if there is none
+	 * @param numExpDigits The number of digits of the exponent, including
+	 *                     leading zeros
+	 */
+	DecimalNotation(Form form,
+		int32_t exp, char expCh, char expSign, uint32_t numExpDigits) :
+		m_form(form),
+		m_exp(exp),
+		m_expCh(expCh),
+		m_expSign(expSign),
+		m_numExpDigits(numExpDigits)
+	{}
+
+	Form m_form;
+	int32_t m_exp;
+	char m_expCh;
+	char m_expSign;
+	uint32_t m_numExpDigits;
+
+}; // struct DecimalNotation
+
+/**
+ * @brief An exact decimal number, which is represented by
+ *        `(-1)^sign * coefficient * 10^exponent`.
+ *        The representation is kept as it is given (e.g., `1.50` is stored as
+ *        `150 * 10^-2`), and so is the notation of a parsed number, so the
+ *        writer can print back exactly what was parsed
+ *
+ * @tparam _CoefType The unsigned integer type used to store the coefficient
+ */
+template<typename _CoefType>
+class DecimalImpl
+{
+public: // static members:
+
+	using CoefType = _CoefType;
+
+public:
+
+	DecimalImpl() :
+		DecimalImpl(false, CoefType(0), 0)
+	{}
+
+	DecimalImpl(bool isNeg, CoefType coef, int32_t exp) :
+		DecimalImpl(isNeg, coef, exp, DecimalNotation())
+	{}
+
+	DecimalImpl(bool isNeg, CoefType coef, int32_t exp,
+		const DecimalNotation& notation) :
+		m_isNeg(isNeg),
+		m_coef(coef),
+		m_exp(exp),
+		m_notation(notation)
+	{}
+
+	~DecimalImpl() = default;
+
+	bool IsNegative() const
+	{
+		return m_isNeg;
+	}
+
+	const CoefType& GetCoef() const
+	{
+		return m_coef;
+	}
+
+	int32_t GetExp() const
+	{
+		return m_exp;
+	}
+
+	const DecimalNotation& GetNotation() const
+	{
+		return m_notation;
+	}
+
+	/**
+	 * @brief Check if two decimals have the same representation;
+	 *        NOTE: `1.5` and `1.50` are *not* equal in this case, while
+	 *        `1.5e1` and `15` are, since the notation isn't compared
+	 *
+	 */
+	bool operator==(const DecimalImpl& other) const
+	{
+		return (m_isNeg == other.m_isNeg) &&
+			(m_coef == other.m_coef) &&
+			(m_exp == other.m_exp);
+	}
+
+	bool operator!=(const DecimalImpl& other) const
+	{
+		return !(*this == other);
+	}
+
+private:
+
+	bool m_isNeg;
+	CoefType m_coef;
+	int32_t m_exp;
+	DecimalNotation m_notation;
+
+}; // class DecimalImpl
+
+} // namespace SimpleJson
@@ -5,24 +5,40 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <string>
 
 #include "NullParser.hpp"
 #include "BoolParser.hpp"
 #include "StringParser.hpp"
+#include "BytesParser.hpp"
 #include "RealNumParser.hpp"
+#include "LazyNumber.hpp"
+#include "Decimal.hpp"
+#include "RawJson.hpp"
 #include "ListParser.hpp"
+#include "NumArrayParser.hpp"
 #include "DictParser.hpp"
 #include "StaticDictParser.hpp"
 
 #include "GenericObjectParser.hpp"
+#include "Arena.hpp"
 
+#include "OutputSink.hpp"
+#include "SerializeCache.hpp"
 #include "NullWriter.hpp"
 #include "RealNumWriter.hpp"
 #include "StringWriter.hpp"
+#include "BytesWriter.hpp"
 #include "ListWriter.hpp"
 #include "DictWriter.hpp"
 #include "ObjectWriter.hpp"
+#include "RawJsonWriter.hpp"
+#include "CanonicalWriter.hpp"
+#include "ParallelWriter.hpp"
+#include "NdJsonWriter.hpp"
+#include "StreamWriter.hpp"
 
 #ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
 namespace SimpleJson
@@ -37,6 +53,7 @@ using ToStringType    = std::string;
 using NullParser = NullParserImpl<IMContainerType, Internal::Obj::Null>;
 using BoolParser = BoolParserImpl<IMContainerType, Internal::Obj::Bool>;
 using StringParser = StringParserImpl<IMContainerType, Internal::Obj::String>;
+using BytesParser = BytesParserImpl<IMContainerType, Internal::Obj::Bytes>;
 
 using DictKeyParser = StringParserImpl<
 	IMContainerType, Internal::Obj::String, Internal::Obj::HashableObject>;
@@ -50,12 +67,30 @@ using GenericNumberParser = GenericNumberParserImpl<
 using IntegerParser = IntegerParserImpl<IMContainerType, Internal::Obj::Int64>;
 using RealNumParser = RealNumParserImpl<IMContainerType, Internal::Obj::Double>;
 
+using LazyNumber = LazyNumberImpl<IMContainerType>;
+using LazyNumberParser = LazyNumberParserImpl<IMContainerType, LazyNumber>;
+
+using Decimal = DecimalImpl<uint64_t>;
+using DecimalParser = DecimalParserImpl<IMContainerType, Decimal>;
+#ifdef __SIZEOF_INT128__
+using Decimal128 = DecimalImpl<Internal::UInt128>;
+using Decimal128Parser = DecimalParserImpl<IMContainerType, Decimal128>;
+#endif // __SIZEOF_INT128__
+
+using RawJson = RawJsonImpl<IMContainerType>;
+
 template<typename _ItemParser>
 using ListParserT = ListParserImpl<
 	IMContainerType,
 	_ItemParser,
 	Internal::Obj::ListT<typename _ItemParser::RetType> >;
 
+template<typename _ValType>
+using NumArrayParserT = NumArrayParserImpl<IMContainerType, _ValType>;
+
+using Int64ArrayParser  = NumArrayParserT<int64_t>;
+using DoubleArrayParser = NumArrayParserT<double>;
+
 template<typename _ValParser>
 using DictParserT = DictParserImpl<
 	IMContainerType,
@@ -76,6 +111,61 @@ using GenericObjectParser = GenericObjectParserImpl<
 	Internal::Obj::DictT,
 	Internal::Obj::Object>;
 
+using ArenaNull   = ArenaNodeT<Internal::Obj::Null, ToStringType>;
+using ArenaBool   = ArenaNodeT<Internal::Obj::Bool, ToStringType>;
+using ArenaInt64  = ArenaNodeT<Internal::Obj::Int64, ToStringType>;
+using ArenaDouble = ArenaNodeT<Internal::Obj::Double, ToStringType>;
+using ArenaString = ArenaNodeT<Internal::Obj::String, ToStringType>;
+
+template<typename _ValType>
+using ArenaListT = ArenaNodeT<Internal::Obj::ListT<_ValType>, ToStringType>;
+
+template<typename _KeyType, typename _ValType>
+using ArenaDictT =
+	ArenaNodeT<Internal::Obj::DictT<_KeyType, _ValType>, ToStringType>;
+
+/**
+ * @brief Parser for generic object, whose nodes are allocated from the arena
+ *        of the current `Internal::ArenaScope` (see `ArenaNodeImpl`); it's
+ *        meant to be used through `ArenaDocument` (e.g., `LoadStrInArena`)
+ *
+ */
+using ArenaGenericObjectParser = GenericObjectParserImpl<
+	IMContainerType,
+	ArenaNull,
+	ArenaBool,
+	ArenaInt64,
+	ArenaDouble,
+	ArenaString,
+	Internal::Obj::HashableObject,
+	ArenaListT,
+	ArenaDictT,
+	Internal::Obj::Object>;
+
+using ArenaDocument = ArenaDocumentImpl<Internal::Obj::Object>;
+
+using LazyInt64  = LazyNumberNodeImpl<Internal::Obj::Int64, ToStringType>;
+using LazyDouble = LazyNumberNodeImpl<Internal::Obj::Double, ToStringType>;
+
+/**
+ * @brief Parser for generic object, whose numbers keep their raw text, so
+ *        they are written back exactly as they are parsed
+ *        (see `LazyNumberNodeImpl`)
+ *
+ */
+using LazyGenericObjectParser = GenericObjectParserImpl<
+	IMContainerType,
+	Internal::Obj::Null,
+	Internal::Obj::Bool,
+	LazyInt64,
+	LazyDouble,
+	Internal::Obj::String,
+	Internal::Obj::HashableObject,
+	Internal::Obj::ListT,
+	Internal::Obj::DictT,
+	Internal::Obj::Object,
+	LazyGenericNumberParserImpl>;
+
 template<
 	typename _ParserTp,
 	bool _AllowMissingItem,
@@ -92,23 +182,73 @@ using StaticDictParserT = StaticDictParserImpl<
 
 // ===================== Writers =====================
 
+using OutputSink = OutputSinkBase<char>;
+using OutputSinkIt = OutputSinkIterator<char>;
+using StringOutputSink = StringOutputSinkImpl<ToStringType>;
+
 using JsonWriterNull = JsonWriterNullImpl<ToStringType>;
 
 using JsonWriterRealNum = JsonWriterRealNumImpl<ToStringType>;
 
+template<typename _NumObjType>
+using JsonWriterNumValT = JsonWriterNumValImpl<_NumObjType>;
+
+using JsonWriterLazyNum = JsonWriterLazyNumImpl<LazyNumber>;
+
+using JsonWriterDecimal = JsonWriterDecimalImpl<Decimal>;
+#ifdef __SIZEOF_INT128__
+using JsonWriterDecimal128 = JsonWriterDecimalImpl<Decimal128>;
+#endif // __SIZEOF_INT128__
+
+using JsonWriterRawJson = JsonWriterRawJsonImpl<RawJson>;
+
 using JsonWriterString = JsonWriterStringImpl<char, ToStringType, IMContainerType>;
 
-template<typename _ValWriter>
+using JsonWriterBytes = JsonWriterBytesImpl<ToStringType>;
+
+template<typename _ValWriter, typename _Policy = PrettyWriterPolicy>
 using JsonWriterListT =
-	JsonWriterListImpl<_ValWriter, ToStringType, IMContainerType>;
+	JsonWriterListImpl<_ValWriter, ToStringType, IMContainerType, _Policy>;
 
-template<typename _KeyWriter, typename _ValWriter>
+template<
+	typename _KeyWriter,
+	typename _ValWriter,
+	typename _Policy = PrettyWriterPolicy>
 using JsonWriterDictT =
-	JsonWriterDictImpl<_KeyWriter, _ValWriter, ToStringType, IMContainerType>;
+	JsonWriterDictImpl<
+		_KeyWriter, _ValWriter, ToStringType, IMContainerType, _Policy>;
+
+template<
+	typename _ValType,
+	typename _ValWriter,
+	typename _Policy = PrettyWriterPolicy>
+using JsonWriterTypedListT =
+	JsonWriterTypedListImpl<
+		_ValType, _ValWriter, ToStringType, IMContainerType, _Policy>;
 
-template<typename _KeyWriter, typename _ValWriter>
+template<
+	typename _KeyType,
+	typename _ValType,
+	typename _KeyWriter,
+	typename _ValWriter,
+	typename _Policy = PrettyWriterPolicy>
+using JsonWriterTypedDictT =
+	JsonWriterTypedDictImpl<
+		_KeyType,
+		_ValType,
+		_KeyWriter,
+		_ValWriter,
+		ToStringType,
+		IMContainerType,
+		_Policy>;
+
+template<
+	typename _KeyWriter,
+	typename _ValWriter,
+	typename _Policy = PrettyWriterPolicy>
 using JsonWriterStaticDictT =
-	JsonWriterStaticDictImpl<_KeyWriter, _ValWriter, ToStringType, IMContainerType>;
+	JsonWriterStaticDictImpl<
+		_KeyWriter, _ValWriter, ToStringType, IMContainerType, _Policy>;
 
 using JsonWriterKey =
 	JsonWriterKeyImpl<
@@ -127,4 +267,31 @@ using JsonWriterObject =
 		ToStringType,
 		IMContainerType>;
 
+using JsonWriterCompactObject =
+	JsonWriterObjectImpl<
+		JsonWriterNull,
+		JsonWriterRealNum,
+		JsonWriterString,
+		JsonWriterKey,
+		ToStringType,
+		IMContainerType,
+		CompactWriterPolicy>;
+
+using NdJsonWriter = NdJsonWriterImpl<JsonWriterCompactObject, ToStringType>;
+
+using JsonWriterParallel =
+	JsonWriterParallelImpl<JsonWriterKey, JsonWriterObject, ToStringType>;
+
+using JsonWriterCompactParallel =
+	JsonWriterParallelImpl<
+		JsonWriterKey,
+		JsonWriterCompactObject,
+		ToStringType,
+		CompactWriterPolicy>;
+
+using JsonWriterCanonical =
+	JsonWriterCanonicalImpl<JsonWriterString, ToStringType>;
+
+using JsonStreamWriter = JsonStreamWriterImpl<JsonWriterString>;
+
 } // namespace SimpleJson
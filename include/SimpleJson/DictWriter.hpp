@@ -5,6 +5,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
 #include "Internal/SimpleObjects.hpp"
 
 #include "Utils.hpp"
@@ -22,7 +31,8 @@ template<
 	typename _ObjWriter,
 	typename _ToStringType,
 	typename _ContainerType,
-	typename _DictTraits>
+	typename _DictTraits,
+	typename _Policy = PrettyWriterPolicy>
 struct JsonWriterDictBase
 {
 
@@ -34,31 +44,31 @@ struct JsonWriterDictBase
 	{
 		*destIt++ = '{';
 
+		std::string newLineCache;
 		WriterStates stateNextLevel = state;
 		++(stateNextLevel.m_nestLevel);
-		size_t len = obj.size();
-
-		if (config.m_indent.size() > 0 && obj.size() > 0)
+		if (stateNextLevel.m_newLineCache == nullptr &&
+			!stateNextLevel.m_isAllocFree)
 		{
-			Internal::RepeatOutput(destIt, config.m_lineEnd, 1);
+			stateNextLevel.m_newLineCache = &newLineCache;
 		}
+		size_t len = obj.size();
 
-		for(auto it = obj.cbegin(); it != obj.cend(); ++it, --len)
+		const auto itEnd = _DictTraits::End(obj);
+		for(auto it = _DictTraits::Begin(obj); it != itEnd; ++it, --len)
 		{
-			if (config.m_indent.size() > 0)
+			if (_Policy::IsPretty(config))
 			{
-				Internal::RepeatOutput(destIt,
-					config.m_indent, stateNextLevel.m_nestLevel);
+				Internal::WriteNewLine(destIt,
+					config, stateNextLevel, stateNextLevel.m_nestLevel);
 			}
 
 			_KeyWriter::Write(destIt,
 				_DictTraits::GetKey(*it), config, stateNextLevel);
 
-			if (config.m_indent.size() > 0)
+			if (_Policy::IsPretty(config))
 			{
-				*destIt++ = ' ';
-				*destIt++ = ':';
-				*destIt++ = ' ';
+				Internal::WriteChars(destIt, " : ", 3);
 			}
 			else
 			{
@@ -72,16 +82,12 @@ struct JsonWriterDictBase
 			{
 				*destIt++ = ',';
 			}
-
-			if (config.m_indent.size() > 0)
-			{
-				Internal::RepeatOutput(destIt, config.m_lineEnd, 1);
-			}
 		}
 
-		if (config.m_indent.size() > 0 && obj.size() > 0)
+		if (_Policy::IsPretty(config) && obj.size() > 0)
 		{
-			Internal::RepeatOutput(destIt, config.m_indent, state.m_nestLevel);
+			Internal::WriteNewLine(destIt,
+				config, stateNextLevel, state.m_nestLevel);
 		}
 		*destIt++ = '}';
 	}
@@ -102,6 +108,16 @@ struct DynamicDictTraits
 
 	typedef std::tuple<key_iterator, const_mapped_iterator>  value_type;
 
+	static typename DictBase::const_iterator Begin(const DictBase& obj)
+	{
+		return obj.cbegin();
+	}
+
+	static typename DictBase::const_iterator End(const DictBase& obj)
+	{
+		return obj.cend();
+	}
+
 	static const key_type& GetKey(const value_type& it)
 	{
 		return *std::get<0>(it);
@@ -114,6 +130,46 @@ struct DynamicDictTraits
 
 }; // struct DynamicDictTraits
 
+/**
+ * @brief Traits for `DictT<_KeyType, _ValType>` (e.g.,
+ *        `DictT<HashableObject, Int64>`), which walk the dict's own storage,
+ *        rather than the type-erased iterators of the base class, so
+ *        values are handed to the value writer as they are, without any
+ *        virtual call or check of their categories per item
+ *
+ */
+template<typename _ToStringType, typename _KeyType, typename _ValType>
+struct TypedDictTraits
+{
+	using DictBase = Internal::Obj::DictT<_KeyType, _ValType>;
+
+	using key_type = _KeyType;
+	using mapped_type = _ValType;
+
+	static auto Begin(const DictBase& obj) -> decltype(obj.begin())
+	{
+		return obj.begin();
+	}
+
+	static auto End(const DictBase& obj) -> decltype(obj.end())
+	{
+		return obj.end();
+	}
+
+	template<typename _ItemType>
+	static const key_type& GetKey(const _ItemType& item)
+	{
+		return item.first;
+	}
+
+	template<typename _ItemType>
+	static const mapped_type& GetVal(const _ItemType& item)
+	{
+		return item.second;
+	}
+
+}; // struct TypedDictTraits
+
 template<typename _ToStringType>
 struct StaticDictTraits
 {
@@ -145,30 +201,220 @@ template<
 	typename _KeyWriter,
 	typename _ObjWriter,
 	typename _ToStringType,
-	typename _ContainerType>
+	typename _ContainerType,
+	typename _Policy = PrettyWriterPolicy>
 struct JsonWriterDictImpl :
 	public JsonWriterDictBase<
 		_KeyWriter,
 		_ObjWriter,
 		_ToStringType,
 		_ContainerType,
-		DynamicDictTraits<_ToStringType> >
+		DynamicDictTraits<_ToStringType>,
+		_Policy>
 {
 }; // struct JsonWriterDictImpl
 
+/**
+ * @brief Writer for `DictT<_KeyType, _ValType>`
+ *
+ * @tparam _ValWriter The writer of `_ValType`
+ */
 template<
+	typename _KeyType,
+	typename _ValType,
 	typename _KeyWriter,
-	typename _ObjWriter,
+	typename _ValWriter,
 	typename _ToStringType,
-	typename _ContainerType>
-struct JsonWriterStaticDictImpl :
+	typename _ContainerType,
+	typename _Policy = PrettyWriterPolicy>
+struct JsonWriterTypedDictImpl :
 	public JsonWriterDictBase<
 		_KeyWriter,
-		_ObjWriter,
+		_ValWriter,
 		_ToStringType,
 		_ContainerType,
-		StaticDictTraits<_ToStringType> >
+		TypedDictTraits<_ToStringType, _KeyType, _ValType>,
+		_Policy>
 {
-}; // struct JsonWriterDictImpl
+}; // struct JsonWriterTypedDictImpl
+
+/**
+ * @brief Writer for static dicts. The keys of a static dict are fixed by its
+ *        type, so they are escaped, together with the separator following
+ *        them, only once per type, and each key is then written by a single
+ *        block copy.
+ *        NOTE: the escaped keys are shared by all threads, and live as long
+ *        as the process
+ *
+ */
+template<
+	typename _KeyWriter,
+	typename _ObjWriter,
+	typename _ToStringType,
+	typename _ContainerType,
+	typename _Policy = PrettyWriterPolicy>
+struct JsonWriterStaticDictImpl
+{
+
+	using DictTraits = StaticDictTraits<_ToStringType>;
+	using DictBase = typename DictTraits::DictBase;
+
+	/**
+	 * @brief The escaped keys of one static dict type, each of which is
+	 *        followed by the separator, `:` or ` : `
+	 *
+	 */
+	struct EscapedKeys
+	{
+		std::vector<std::string> m_compact;
+		std::vector<std::string> m_pretty;
+	}; // struct EscapedKeys
+
+	/**
+	 * @brief The escaped keys of one static dict type, in both ways of
+	 *        writing non-ASCII characters, each of which is built once
+	 *
+	 */
+	struct TypeEntry
+	{
+		explicit TypeEntry(const std::type_info& type) :
+			m_type(type),
+			m_next(nullptr)
+		{}
+
+		const std::type_info& m_type;
+		TypeEntry* m_next;
+		std::once_flag m_builtFlags[2];
+		EscapedKeys m_keys[2];
+	}; // struct TypeEntry
+
+	inline static const EscapedKeys& GetEscapedKeys(
+		const DictBase& obj,
+		const WriterConfig& config,
+		const WriterStates& state)
+	{
+		TypeEntry& entry = GetTypeEntry(typeid(obj));
+
+		// the escaped form also depends on the way non-ASCII characters
+		// are written
+		const size_t idx = config.m_escapeUnicode ? 1 : 0;
+		std::call_once(entry.m_builtFlags[idx],
+			[&]()
+			{
+				EscapeKeys(entry.m_keys[idx], obj, config, state);
+			}
+		);
+		return entry.m_keys[idx];
+	}
+
+	template<typename _OutputIt>
+	inline static void Write(_OutputIt destIt,
+		const DictBase& obj,
+		const WriterConfig& config,
+		const WriterStates& state)
+	{
+		*destIt++ = '{';
+
+		std::string newLineCache;
+		WriterStates stateNextLevel = state;
+		++(stateNextLevel.m_nestLevel);
+		if (stateNextLevel.m_newLineCache == nullptr &&
+			!stateNextLevel.m_isAllocFree)
+		{
+			stateNextLevel.m_newLineCache = &newLineCache;
+		}
+
+		const EscapedKeys& keys =
+			GetEscapedKeys(obj, config, stateNextLevel);
+		const std::vector<std::string>& keyStrs =
+			_Policy::IsPretty(config) ? keys.m_pretty : keys.m_compact;
+
+		size_t i = 0;
+		for(auto it = obj.cbegin(); it != obj.cend(); ++it, ++i)
+		{
+			if (i != 0)
+			{
+				*destIt++ = ',';
+			}
+
+			if (_Policy::IsPretty(config))
+			{
+				Internal::WriteNewLine(destIt,
+					config, stateNextLevel, stateNextLevel.m_nestLevel);
+			}
+
+			Internal::WriteChars(destIt, keyStrs[i].data(), keyStrs[i].size());
+
+			_ObjWriter::Write(destIt,
+				DictTraits::GetVal(*it), config, stateNextLevel);
+		}
+
+		if (_Policy::IsPretty(config) && i > 0)
+		{
+			Internal::WriteNewLine(destIt,
+				config, stateNextLevel, state.m_nestLevel);
+		}
+		*destIt++ = '}';
+	}
+
+private:
+
+	/**
+	 * @brief Get the entry of the given type, which is added on the first
+	 *        call for the type. The entries are kept in a lock-free list,
+	 *        since entries are only ever prepended, and never removed; so
+	 *        looking up a type only takes a few pointer comparisons, given
+	 *        that a program only has a few static dict types.
+	 *
+	 */
+	inline static TypeEntry& GetTypeEntry(const std::type_info& type)
+	{
+		static std::atomic<TypeEntry*> s_head(nullptr);
+
+		TypeEntry* head = s_head.load(std::memory_order_acquire);
+		for (TypeEntry* it = head; it != nullptr; it = it->m_next)
+		{
+			if (it->m_type == type)
+			{
+				return *it;
+			}
+		}
+
+		std::unique_ptr<TypeEntry> entry(new TypeEntry(type));
+		entry->m_next = head;
+		while (!s_head.compare_exchange_weak(entry->m_next, entry.get(),
+			std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			// other entries have been added in the meantime
+			for (TypeEntry* it = entry->m_next; it != head; it = it->m_next)
+			{
+				if (it->m_type == type)
+				{
+					return *it;
+				}
+			}
+			head = entry->m_next;
+		}
+		return *(entry.release());
+	}
+
+	inline static void EscapeKeys(
+		EscapedKeys& keys,
+		const DictBase& obj,
+		const WriterConfig& config,
+		const WriterStates& state)
+	{
+		for (auto itItem = obj.cbegin(); itItem != obj.cend(); ++itItem)
+		{
+			std::string key;
+			_KeyWriter::Write(std::back_inserter(key),
+				DictTraits::GetKey(*itItem), config, state);
+
+			keys.m_compact.push_back(key + ":");
+			keys.m_pretty.push_back(key + " : ");
+		}
+	}
+
+}; // struct JsonWriterStaticDictImpl
 
 } // namespace SimpleJson
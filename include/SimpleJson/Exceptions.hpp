@@ -118,4 +118,28 @@ public:
 
 }; // class SerializeTypeError
 
+/**
+ * @brief This exception is thrown when a value of a supported type can't be
+ *        written into JSON string (e.g., a string with invalid UTF-8
+ *        encoding).
+ */
+class SerializeValueError : public Exception
+{
+
+public:
+
+	explicit SerializeValueError(const std::string& issue) :
+		Exception("Cannot serialize value - " + issue)
+	{}
+
+	// LCOV_EXCL_START
+	/**
+	 * @brief Destroy the SerializeValueError object
+	 *
+	 */
+	virtual ~SerializeValueError() = default;
+	// LCOV_EXCL_STOP
+
+}; // class SerializeValueError
+
 } // namespace SimpleJson
@@ -21,7 +21,11 @@ namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
 
 
 /**
- * @brief Parser for generic object
+ * @brief Parser for generic object.
+ *        NOTE: the memory of every parsed node is managed by the node types
+ *        given below, and the parser never allocates nodes by itself; e.g.,
+ *        `ArenaGenericObjectParser` places nodes in an arena by giving node
+ *        types that allocate from it
  *
  * @tparam _ContainerType Type of containers which *may* be needed during
  *                        intermediate steps.
@@ -30,6 +34,10 @@ namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
  * @tparam _IntType       The type used to construct the integer type
  * @tparam _RealType      The type used to construct the real type
  * @tparam _RetType       The type that will be returned by the parser
+ * @tparam _NumParserType The parser used for numbers, which is given
+ *                        `(_ContainerType, _IntType, _RealType, _RetType)`;
+ *                        e.g., `LazyGenericNumberParserImpl` keeps the text
+ *                        of numbers (see `LazyGenericObjectParser`)
  */
 template<
 	typename _ContainerType,
@@ -41,7 +49,9 @@ template<
 	typename _HashObjType,
 	template<typename> class _ListType,
 	template<typename,typename> class _DictType,
-	typename _RetType>
+	typename _RetType,
+	template<typename, typename, typename, typename> class _NumParserType =
+		GenericNumberParserImpl>
 class GenericObjectParserImpl : public ParserBase<_ContainerType, _RetType>
 {
 public: // static members:
@@ -57,7 +67,8 @@ public: // static members:
 		_HashObjType,
 		_ListType,
 		_DictType,
-		_RetType>;
+		_RetType,
+		_NumParserType>;
 
 	using ContainerType = _ContainerType;
 	using InputChType   = typename ContainerType::value_type;
@@ -70,7 +81,7 @@ public: // static members:
 	using BoolParser = BoolParserImpl<_ContainerType, _BoolType>;
 
 	using GenericNumberParser =
-		GenericNumberParserImpl<_ContainerType, _IntType, _RealType, RetType>;
+		_NumParserType<_ContainerType, _IntType, _RealType, RetType>;
 
 	using StringParser =
 		StringParserImpl<_ContainerType, _StrType>;
@@ -225,8 +236,70 @@ public:
 			ism.GetLineCount(), ism.GetColCount());
 	}
 
+	using Base::ParseInto;
+
+	/**
+	 * @brief If the target holds a string or a list, and the input is of the
+	 *        same category, the node held is parsed into in place, so its
+	 *        memory is reused all the way down the list;
+	 *        otherwise (including dicts), the target is replaced
+	 *
+	 */
+	virtual void ParseInto(
+		InputStateMachineIf<InputChType>& ism, RetType& target) const override
+	{
+		auto ch = ism.SkipSpaceAndGetChar();
+
+		switch(ch)
+		{
+			case '\"':  // "..."  -- String
+				if ((target.GetCategory() ==
+						Internal::Obj::ObjCategory::String) &&
+					TryParseInto(ism, target.AsString(), *GetStringParser()))
+				{
+					return;
+				}
+				break;
+			case '[':   // []     -- List
+				if ((target.GetCategory() ==
+						Internal::Obj::ObjCategory::List) &&
+					TryParseInto(ism, target.AsList(), *GetListParser()))
+				{
+					return;
+				}
+				break;
+			default:
+				break;
+		}
+
+		target = Parse(ism);
+	}
+
 private:
 
+	/**
+	 * @brief Parse into the node held by the target, which is given by
+	 *        `AsString()` or `AsList()`, if the node is of the type returned
+	 *        by the given parser
+	 *
+	 * @return whether the node is parsed into
+	 */
+	template<typename _NodeBaseType, typename _ParserType>
+	static bool TryParseInto(InputStateMachineIf<InputChType>& ism,
+		_NodeBaseType& nodeBase, const _ParserType& parser)
+	{
+		using NodeType = typename _ParserType::RetType;
+
+		auto node = dynamic_cast<NodeType*>(&nodeBase);
+		if (node == nullptr)
+		{
+			return false;
+		}
+
+		parser.ParseInto(ism, *node);
+		return true;
+	}
+
 	mutable NullParserPtr m_nullParser;
 	mutable BoolParserPtr m_boolParser;
 	mutable GenericNumberParserPtr m_numberParser;
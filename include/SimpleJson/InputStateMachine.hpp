@@ -6,6 +6,8 @@
 #pragma once
 
 #include <iterator>
+#include <type_traits>
+#include <utility>
 
 #include "Exceptions.hpp"
 #include "Utils.hpp"
@@ -122,6 +124,37 @@ public:
 	 */
 	virtual value_type GetChar() = 0;
 
+	/**
+	 * @brief Get the rest of the input as a block of contiguous characters,
+	 *        starting from the current position. This allows the caller to
+	 *        process multiple characters at a time.
+	 *        The default implementation doesn't have a contiguous block
+	 *
+	 * @return a pair of pointers to the begin and the end of the block;
+	 *         both of them are `nullptr` if the input is not stored in
+	 *         contiguous memory
+	 */
+	virtual std::pair<const value_type*, const value_type*> GetBlock() const
+	{
+		return std::make_pair(nullptr, nullptr);
+	}
+
+	/**
+	 * @brief Advance the current position by `n` characters at once.
+	 *        NOTE: the caller must ensure that all these `n` characters
+	 *        are available, and none of them is a line ending character
+	 *        (i.e., `\\n` or `\\r`)
+	 *
+	 * @param n The number of characters to skip
+	 */
+	virtual void AdvanceInLine(size_t n)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			this->GetCharAndAdv();
+		}
+	}
+
 	/**
 	 * @brief Expecting a delimiter.
 	 *        1) skip whitespaces until there is a non-whitespace char
@@ -457,8 +490,35 @@ public:
 				m_lineNum, m_colNum));
 	}
 
+	virtual std::pair<const value_type*, const value_type*>
+	GetBlock() const override
+	{
+		return GetBlockImpl(std::is_pointer<_ForwardItType>());
+	}
+
+	virtual void AdvanceInLine(size_t n) override
+	{
+		std::advance(m_begin, n);
+		m_colNum += n;
+		m_current = IsEnd() ? '\0' : *m_begin;
+	}
+
 private:
 
+	// The iterator is a pointer, so the input is stored contiguously
+	std::pair<const value_type*, const value_type*>
+	GetBlockImpl(std::true_type) const
+	{
+		return std::pair<const value_type*, const value_type*>(
+			m_begin, m_end);
+	}
+
+	std::pair<const value_type*, const value_type*>
+	GetBlockImpl(std::false_type) const
+	{
+		return Base::GetBlock();
+	}
+
 	_ForwardItType m_begin;
 	_ForwardItType m_end;
 	size_t m_lineNum;
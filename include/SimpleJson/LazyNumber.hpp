@@ -0,0 +1,233 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstdlib>
+
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "RealNumParser.hpp"
+#include "Internal/SimpleObjects.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A number that keeps the raw text parsed from the JSON string, and
+ *        it's only converted to the numeric value on the first access.
+ *        This is useful when most of numbers in a document are only
+ *        forwarded, since writing it back costs nothing but a copy.
+ *        NOTE: the converted value is cached in the object, so accessing the
+ *        value of the *same* object from multiple threads is not thread-safe;
+ *        for numbers held by generic objects, see `LazyNumberNodeImpl`
+ *
+ * @tparam _ContainerType The type of container used to store the raw text
+ */
+template<typename _ContainerType>
+class LazyNumberImpl
+{
+public: // static members:
+
+	using ContainerType = _ContainerType;
+
+public:
+
+	LazyNumberImpl() :
+		LazyNumberImpl(ContainerType(1, '0'), true)
+	{}
+
+	/**
+	 * @brief Construct a new Lazy Number object
+	 *
+	 * @param raw   The raw text of the number, which must be a valid JSON
+	 *              number; it's the caller's responsibility to validate it
+	 * @param isInt Whether or not the raw text is an integer (i.e., no
+	 *              fraction part and no exponential part)
+	 */
+	LazyNumberImpl(ContainerType raw, bool isInt) :
+		m_raw(std::move(raw)),
+		m_isInt(isInt),
+		m_isDecoded(false),
+		m_intVal(0),
+		m_realVal(0.0)
+	{}
+
+	~LazyNumberImpl() = default;
+
+	bool IsInteger() const
+	{
+		return m_isInt;
+	}
+
+	const ContainerType& GetRaw() const
+	{
+		return m_raw;
+	}
+
+	long long AsInt64() const
+	{
+		Decode();
+		return m_intVal;
+	}
+
+	double AsDouble() const
+	{
+		Decode();
+		return m_realVal;
+	}
+
+	bool operator==(const LazyNumberImpl& other) const
+	{
+		return (m_isInt == other.m_isInt) && (m_raw == other.m_raw);
+	}
+
+	bool operator!=(const LazyNumberImpl& other) const
+	{
+		return !(*this == other);
+	}
+
+private:
+
+	void Decode() const
+	{
+		if (m_isDecoded)
+		{
+			return;
+		}
+
+		if (m_isInt)
+		{
+			m_intVal = Internal::IntStrToInt64(m_raw);
+			m_realVal = static_cast<double>(m_intVal);
+		}
+		else
+		{
+			m_realVal = atof(m_raw.c_str());
+			// truncate towards zero, and saturate if it's out of range
+			m_intVal =
+				(m_realVal >= 9223372036854775807.0) ?
+					std::numeric_limits<long long>::max() :
+				(m_realVal <= -9223372036854775808.0) ?
+					std::numeric_limits<long long>::min() :
+					static_cast<long long>(m_realVal);
+		}
+		m_isDecoded = true;
+	}
+
+	ContainerType m_raw;
+	bool m_isInt;
+
+	mutable bool m_isDecoded;
+	mutable long long m_intVal;
+	mutable double m_realVal;
+
+}; // class LazyNumberImpl
+
+/**
+ * @brief The interface of lazy number nodes, through which the writers get
+ *        the raw text of the number (see `JsonWriterRealNumImpl`)
+ *
+ */
+template<typename _ToStringType>
+class LazyNumberNodeBase
+{
+public:
+
+	LazyNumberNodeBase() = default;
+
+	// LCOV_EXCL_START
+	virtual ~LazyNumberNodeBase() = default;
+	// LCOV_EXCL_STOP
+
+	virtual const _ToStringType& GetRaw() const = 0;
+
+}; // class LazyNumberNodeBase
+
+/**
+ * @brief A number node type (e.g., `Int64`) that also keeps the raw text
+ *        parsed from the JSON string, so it can be held by the generic
+ *        object holders (i.e., `Object`), and it's written back as the raw
+ *        text, byte for byte, instead of being formatted from its value.
+ *        `ToString` returns the raw text as well.
+ *        NOTE: unlike `LazyNumberImpl`, the value is still converted when
+ *        the number is parsed, since the node is a complete `_BaseType`;
+ *        what's saved in forwarding pipelines is the formatting on writing
+ *
+ * @tparam _BaseType The number node type from SimpleObjects
+ */
+template<typename _BaseType, typename _ToStringType>
+class LazyNumberNodeImpl :
+	public _BaseType,
+	public LazyNumberNodeBase<_ToStringType>
+{
+public: // static members:
+
+	using Base = _BaseType;
+	using LazyBase = LazyNumberNodeBase<_ToStringType>;
+	using BaseObjType = Internal::Obj::BaseObject<_ToStringType>;
+	using HashableBaseObjType =
+		Internal::Obj::HashableBaseObject<_ToStringType>;
+
+public:
+
+	/**
+	 * @param raw The raw text of the number, which must be a valid JSON
+	 *            number; it's the caller's responsibility to validate it
+	 * @param val The value of the number
+	 */
+	template<typename _ValType>
+	LazyNumberNodeImpl(_ToStringType raw, _ValType val) :
+		Base(val),
+		LazyBase(),
+		m_raw(std::move(raw))
+	{}
+
+	LazyNumberNodeImpl(const LazyNumberNodeImpl& other) = default;
+
+	LazyNumberNodeImpl(LazyNumberNodeImpl&& other) = default;
+
+	// LCOV_EXCL_START
+	virtual ~LazyNumberNodeImpl() = default;
+	// LCOV_EXCL_STOP
+
+	LazyNumberNodeImpl& operator=(const LazyNumberNodeImpl& other) = default;
+
+	LazyNumberNodeImpl& operator=(LazyNumberNodeImpl&& other) = default;
+
+	virtual const _ToStringType& GetRaw() const override
+	{
+		return m_raw;
+	}
+
+	virtual _ToStringType ToString() const override
+	{
+		return m_raw;
+	}
+
+	virtual std::unique_ptr<BaseObjType> CloneBase() const override
+	{
+		return std::unique_ptr<BaseObjType>(new LazyNumberNodeImpl(*this));
+	}
+
+	virtual std::unique_ptr<HashableBaseObjType> CloneHashable() const override
+	{
+		return std::unique_ptr<HashableBaseObjType>(
+			new LazyNumberNodeImpl(*this));
+	}
+
+private:
+
+	_ToStringType m_raw;
+
+}; // class LazyNumberNodeImpl
+
+} // namespace SimpleJson
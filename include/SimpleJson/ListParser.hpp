@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "ParserBase.hpp"
 #include "Internal/make_unique.hpp"
 
@@ -91,11 +93,37 @@ public:
 		return Parse2Obj(ism);
 	}
 
+	using Base::ParseInto;
+
+	/**
+	 * @brief Items already in the target list are parsed into in place, and
+	 *        the list is only grown or shrunk by the difference, so both the
+	 *        capacity of the list and the memory held by its items are reused
+	 *
+	 */
+	virtual void ParseInto(
+		InputStateMachineIf<InputChType>& ism, RetType& target) const override
+	{
+		ParseIntoImpl(ism, target, std::is_same<RetType, ObjType>());
+	}
+
 protected:
 
 	ObjType Parse2Obj(InputStateMachineIf<InputChType>& ism) const
 	{
 		ObjType l;
+		Parse2Obj(ism, l);
+		return l;
+	}
+
+	/**
+	 * @brief Parse the list into `l`, where existing items are reused; `l` is
+	 *        resized to the number of items parsed
+	 *
+	 */
+	void Parse2Obj(InputStateMachineIf<InputChType>& ism, ObjType& l) const
+	{
+		size_t count = 0;
 
 		auto ch = ism.SkipSpaceAndGetCharAndAdv();
 
@@ -106,11 +134,15 @@ protected:
 			if (ch == ']')
 			{
 				ism.GetCharAndAdv(); // consume ']'
-				return l;
+				if (l.size() > 0)
+				{
+					l.resize(0);
+				}
+				return;
 			}
 			else
 			{
-				l.push_back(m_itemParser->Parse(ism));
+				ParseItem(ism, l, count++);
 			}
 
 			// Check if there is following items
@@ -118,7 +150,7 @@ protected:
 			while(ch == ',')
 			{
 				ism.GetCharAndAdv(); // consume ','
-				l.push_back(m_itemParser->Parse(ism));
+				ParseItem(ism, l, count++);
 
 				ch = ism.SkipSpaceAndGetChar();
 			}
@@ -127,7 +159,11 @@ protected:
 			if (ch == ']')
 			{
 				ism.GetCharAndAdv(); // consume ']'
-				return l;
+				if (count < l.size())
+				{
+					l.resize(count);
+				}
+				return;
 			}
 		}
 
@@ -137,6 +173,31 @@ protected:
 
 private:
 
+	void ParseItem(InputStateMachineIf<InputChType>& ism,
+		ObjType& l, size_t idx) const
+	{
+		if (idx < l.size())
+		{
+			m_itemParser->ParseInto(ism, l[idx]);
+		}
+		else
+		{
+			l.push_back(m_itemParser->Parse(ism));
+		}
+	}
+
+	void ParseIntoImpl(InputStateMachineIf<InputChType>& ism,
+		RetType& target, std::true_type) const
+	{
+		Parse2Obj(ism, target);
+	}
+
+	void ParseIntoImpl(InputStateMachineIf<InputChType>& ism,
+		RetType& target, std::false_type) const
+	{
+		target = Parse2Obj(ism);
+	}
+
 	ItemParserPtr m_itemParser;
 
 }; // class ListParserImpl
@@ -17,12 +17,16 @@ namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
 #endif
 {
 
-template<typename _ObjWriter, typename _ToStringType, typename _ContainerType>
-struct JsonWriterListImpl
+template<
+	typename _ObjWriter,
+	typename _ToStringType,
+	typename _ContainerType,
+	typename _ListTraits,
+	typename _Policy = PrettyWriterPolicy>
+struct JsonWriterListBase
 {
 
-	using ListBase =
-		typename Internal::Obj::BaseObject<_ToStringType>::ListBase;
+	using ListBase = typename _ListTraits::ListBase;
 
 	template<typename _OutputIt>
 	inline static void Write(_OutputIt destIt,
@@ -32,43 +36,134 @@ struct JsonWriterListImpl
 	{
 		*destIt++ = '[';
 
-		if (config.m_indent.size() > 0 && obj.size() > 0)
-		{
-			Internal::RepeatOutput(destIt, config.m_lineEnd, 1);
-		}
-
+		std::string newLineCache;
 		WriterStates stateNextLevel = state;
 		++(stateNextLevel.m_nestLevel);
+		if (stateNextLevel.m_newLineCache == nullptr &&
+			!stateNextLevel.m_isAllocFree)
+		{
+			stateNextLevel.m_newLineCache = &newLineCache;
+		}
 		size_t len = obj.size();
 
-		for(auto it = obj.cbegin(); it != obj.cend(); ++it, --len)
+		const auto itEnd = _ListTraits::End(obj);
+		for(auto it = _ListTraits::Begin(obj); it != itEnd; ++it, --len)
 		{
-			if (config.m_indent.size() > 0)
+			if (_Policy::IsPretty(config))
 			{
-				Internal::RepeatOutput(destIt,
-					config.m_indent, stateNextLevel.m_nestLevel);
+				Internal::WriteNewLine(destIt,
+					config, stateNextLevel, stateNextLevel.m_nestLevel);
 			}
 
-			_ObjWriter::Write(destIt, *it, config, stateNextLevel);
+			_ObjWriter::Write(destIt,
+				_ListTraits::GetVal(*it), config, stateNextLevel);
 
 			if (len != 1)
 			{
 				*destIt++ = ',';
 			}
-
-			if (config.m_indent.size() > 0)
-			{
-				Internal::RepeatOutput(destIt, config.m_lineEnd, 1);
-			}
 		}
 
-		if (config.m_indent.size() > 0 && obj.size() > 0)
+		if (_Policy::IsPretty(config) && obj.size() > 0)
 		{
-			Internal::RepeatOutput(destIt, config.m_indent, state.m_nestLevel);
+			Internal::WriteNewLine(destIt,
+				config, stateNextLevel, state.m_nestLevel);
 		}
 		*destIt++ = ']';
 	}
 
+}; // struct JsonWriterListBase
+
+template<typename _ToStringType>
+struct DynamicListTraits
+{
+	using ListBase =
+		typename Internal::Obj::BaseObject<_ToStringType>::ListBase;
+
+	using mapped_type = Internal::Obj::BaseObject<_ToStringType>;
+
+	static typename ListBase::const_iterator Begin(const ListBase& obj)
+	{
+		return obj.cbegin();
+	}
+
+	static typename ListBase::const_iterator End(const ListBase& obj)
+	{
+		return obj.cend();
+	}
+
+	static const mapped_type& GetVal(const mapped_type& val)
+	{
+		return val;
+	}
+
+}; // struct DynamicListTraits
+
+/**
+ * @brief Traits for `ListT<_ValType>` (e.g., `ListT<Int64>`), which walk the
+ *        list's own storage, rather than the type-erased iterators of the
+ *        base class, so items are handed to the item writer as they are,
+ *        without any virtual call or check of their categories per item
+ *
+ */
+template<typename _ToStringType, typename _ValType>
+struct TypedListTraits
+{
+	using ListBase = Internal::Obj::ListT<_ValType>;
+
+	using mapped_type = _ValType;
+
+	static auto Begin(const ListBase& obj) -> decltype(obj.begin())
+	{
+		return obj.begin();
+	}
+
+	static auto End(const ListBase& obj) -> decltype(obj.end())
+	{
+		return obj.end();
+	}
+
+	static const mapped_type& GetVal(const mapped_type& val)
+	{
+		return val;
+	}
+
+}; // struct TypedListTraits
+
+template<
+	typename _ObjWriter,
+	typename _ToStringType,
+	typename _ContainerType,
+	typename _Policy = PrettyWriterPolicy>
+struct JsonWriterListImpl :
+	public JsonWriterListBase<
+		_ObjWriter,
+		_ToStringType,
+		_ContainerType,
+		DynamicListTraits<_ToStringType>,
+		_Policy>
+{
 }; // struct JsonWriterListImpl
 
+/**
+ * @brief Writer for `ListT<_ValType>`
+ *
+ * @tparam _ValWriter The writer of `_ValType`
+ */
+template<
+	typename _ValType,
+	typename _ValWriter,
+	typename _ToStringType,
+	typename _ContainerType,
+	typename _Policy = PrettyWriterPolicy>
+struct JsonWriterTypedListImpl :
+	public JsonWriterListBase<
+		_ValWriter,
+		_ToStringType,
+		_ContainerType,
+		TypedListTraits<_ToStringType, _ValType>,
+		_Policy>
+{
+}; // struct JsonWriterTypedListImpl
+
 } // namespace SimpleJson
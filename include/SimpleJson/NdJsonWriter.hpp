@@ -0,0 +1,104 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <utility>
+
+#include "OutputSink.hpp"
+#include "WriterConfig.hpp"
+#include "Internal/SimpleObjects.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief Writer for newline-delimited JSON (NDJSON, a.k.a. JSON Lines),
+ *        which writes each record as a single line, followed by `\n`, to
+ *        one shared output sink, so records are neither allocated nor copied
+ *        one by one, and the sink is drained in large blocks.
+ *        The indentation settings in `WriterConfig` are ignored, since each
+ *        record must fit in one line; line breaks in strings are always
+ *        escaped.
+ *        NOTE: the sink is *not* flushed by this writer
+ *
+ * @tparam _ObjWriter The object writer, which must write compact output
+ *                    (e.g., one using `CompactWriterPolicy`)
+ */
+template<typename _ObjWriter, typename _ToStringType>
+class NdJsonWriterImpl
+{
+public: // static members:
+
+	using ObjType = Internal::Obj::BaseObject<_ToStringType>;
+	using SinkType = OutputSinkBase<char>;
+	using OutputIt = OutputSinkIterator<char>;
+
+public:
+
+	explicit NdJsonWriterImpl(
+		SinkType& sink,
+		WriterConfig config = WriterConfig()) :
+		m_sink(sink),
+		m_config(std::move(config)),
+		m_state(),
+		m_count(0)
+	{
+		m_config.m_indent.clear();
+	}
+
+	NdJsonWriterImpl(const NdJsonWriterImpl& other) = delete;
+
+	~NdJsonWriterImpl() = default;
+
+	NdJsonWriterImpl& operator=(const NdJsonWriterImpl& other) = delete;
+
+	/**
+	 * @brief Write one record, followed by a line break
+	 *
+	 */
+	void Write(const ObjType& obj)
+	{
+		_ObjWriter::Write(OutputIt(m_sink), obj, m_config, m_state);
+		m_sink.Put('\n');
+		++m_count;
+	}
+
+	/**
+	 * @brief Write all records in the range `[begin, end)`
+	 *
+	 */
+	template<typename _ItType>
+	void Write(_ItType begin, _ItType end)
+	{
+		for (; begin != end; ++begin)
+		{
+			Write(*begin);
+		}
+	}
+
+	/**
+	 * @brief Get the number of records written so far
+	 *
+	 */
+	size_t GetCount() const
+	{
+		return m_count;
+	}
+
+private:
+
+	SinkType& m_sink;
+	WriterConfig m_config;
+	WriterStates m_state;
+	size_t m_count;
+
+}; // class NdJsonWriterImpl
+
+} // namespace SimpleJson
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "Utils.hpp"
 #include "WriterConfig.hpp"
 
 #ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
@@ -22,10 +23,7 @@ struct JsonWriterNullImpl
 		const WriterConfig&,
 		const WriterStates&)
 	{
-		*it++ = 'n';
-		*it++ = 'u';
-		*it++ = 'l';
-		*it++ = 'l';
+		Internal::WriteChars(it, "null", 4);
 	}
 }; // struct JsonWriterNullImpl
 
@@ -0,0 +1,287 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "RealNumParser.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+
+/**
+ * @brief Parser for a list that only contains numbers of the same type.
+ *        Numbers are parsed in place and stored directly in a contiguous
+ *        container (e.g., `std::vector<double>`), so there is no item parser
+ *        to dispatch to, and no boxed object for each item.
+ *        - For integer type, only integers are accepted
+ *        - For floating point type, both integers and real numbers
+ *          are accepted
+ *        - Numbers that don't fit in the value type are rejected, rather
+ *          than wrapped around or truncated
+ *
+ * @tparam _ContainerType Type of containers which *may* be needed during
+ *                        intermediate steps.
+ *                        Meanwhile, the input character type is inferred by
+ *                        `_ContainerType::value_type`
+ * @tparam _ValType       The C++ numeric type of each item in the list
+ * @tparam _ObjType       The type of the list object
+ * @tparam _RetType       The type that will be returned by the parser
+ */
+template<
+	typename _ContainerType,
+	typename _ValType,
+	typename _ObjType = std::vector<_ValType>,
+	typename _RetType = _ObjType>
+class NumArrayParserImpl : public ParserBase<_ContainerType, _RetType>
+{
+public: // static members:
+
+	using Base = ParserBase<_ContainerType, _RetType>;
+	using Self = NumArrayParserImpl<
+		_ContainerType, _ValType, _ObjType, _RetType>;
+
+	using ContainerType = _ContainerType;
+	using InputChType   = typename ContainerType::value_type;
+	using ValType       = _ValType;
+	using ObjType       = _ObjType;
+	using RetType       = _RetType;
+	using IteratorType  = Internal::Obj::FrIterator<InputChType, true>;
+	using ISMType       = ForwardIteratorStateMachine<IteratorType>;
+
+	static_assert(std::is_arithmetic<ValType>::value &&
+		!std::is_same<ValType, bool>::value,
+		"The value type of the number array must be a numeric type");
+
+public:
+
+	NumArrayParserImpl() = default;
+
+	// LCOV_EXCL_START
+	virtual ~NumArrayParserImpl() = default;
+	// LCOV_EXCL_STOP
+
+	using Base::Parse;
+
+	virtual RetType Parse(InputStateMachineIf<InputChType>& ism) const override
+	{
+		return Parse2Obj(ism);
+	}
+
+	using Base::ParseInto;
+
+	/**
+	 * @brief Numbers are parsed into the target container after clearing
+	 *        it, so its capacity is reused
+	 *
+	 */
+	virtual void ParseInto(
+		InputStateMachineIf<InputChType>& ism, RetType& target) const override
+	{
+		ParseIntoImpl(ism, target, std::is_same<RetType, ObjType>());
+	}
+
+protected:
+
+	ObjType Parse2Obj(InputStateMachineIf<InputChType>& ism) const
+	{
+		ObjType l;
+		Parse2Obj(ism, l);
+		return l;
+	}
+
+	/**
+	 * @brief Parse the list by appending numbers to `l`
+	 *
+	 */
+	void Parse2Obj(InputStateMachineIf<InputChType>& ism, ObjType& l) const
+	{
+		// scratch buffer shared by all items in the list
+		ContainerType buf;
+
+		auto ch = ism.SkipSpaceAndGetCharAndAdv();
+
+		if (ch == '[')
+		{
+			// check if there is at least one element
+			ch = ism.SkipSpaceAndGetChar();
+			if (ch == ']')
+			{
+				ism.GetCharAndAdv(); // consume ']'
+				return;
+			}
+			else
+			{
+				l.push_back(ParseItem(ism, buf));
+			}
+
+			// Check if there is following items
+			ch = ism.SkipSpaceAndGetChar();
+			while(ch == ',')
+			{
+				ism.GetCharAndAdv(); // consume ','
+				l.push_back(ParseItem(ism, buf));
+
+				ch = ism.SkipSpaceAndGetChar();
+			}
+
+			// approach to the end of list
+			if (ch == ']')
+			{
+				ism.GetCharAndAdv(); // consume ']'
+				return;
+			}
+		}
+
+		throw ParseError("Unexpected character",
+			ism.GetLineCount(), ism.GetColCount());
+	}
+
+private:
+
+	void ParseIntoImpl(InputStateMachineIf<InputChType>& ism,
+		RetType& target, std::true_type) const
+	{
+		target.clear();
+		Parse2Obj(ism, target);
+	}
+
+	void ParseIntoImpl(InputStateMachineIf<InputChType>& ism,
+		RetType& target, std::false_type) const
+	{
+		target = Parse2Obj(ism);
+	}
+
+	static ValType ParseItem(
+		InputStateMachineIf<InputChType>& ism, ContainerType& buf)
+	{
+		ism.SkipWhiteSpace();
+
+		buf.clear();
+		bool isInt = Internal::ParseNumInto(ism, buf);
+
+		return ToValue(ism, buf, isInt, std::is_floating_point<ValType>());
+	}
+
+	static ValType ToValue(
+		InputStateMachineIf<InputChType>& ism,
+		const ContainerType& buf,
+		bool,
+		std::true_type)
+	{
+		const double val = atof(buf.c_str());
+		// values out of the range of a narrower type (e.g., 1e39 for float)
+		// can't be converted
+		if (std::isfinite(val) &&
+			(val > static_cast<double>(std::numeric_limits<ValType>::max()) ||
+			val < static_cast<double>(std::numeric_limits<ValType>::lowest())))
+		{
+			throw ParseError("The number is out of the range of the value type",
+				ism.GetLineCount(), ism.GetColCount());
+		}
+		return static_cast<ValType>(val);
+	}
+
+	static ValType ToValue(
+		InputStateMachineIf<InputChType>& ism,
+		const ContainerType& buf,
+		bool isInt,
+		std::false_type)
+	{
+		if (!isInt)
+		{
+			throw ParseError(
+				"Expecteding a integer while a real number is parsed",
+				ism.GetLineCount(), ism.GetColCount());
+		}
+
+		const InputChType* begin = buf.data();
+		const InputChType* end = buf.data() + buf.size();
+
+		const bool isNeg = (*begin == '-');
+		begin += (isNeg ? 1 : 0);
+
+		const uint64_t mag = DigitsToUInt64(ism, begin, end);
+
+		// the magnitude of the lowest value of a signed type is one more
+		// than the max value, while it's 0 for an unsigned type
+		constexpr uint64_t posMax =
+			static_cast<uint64_t>(std::numeric_limits<ValType>::max());
+		constexpr uint64_t negMax = std::is_signed<ValType>::value ?
+			(posMax + 1) : 0;
+
+		if (mag > (isNeg ? negMax : posMax))
+		{
+			throw ParseError("The number is out of the range of the value type",
+				ism.GetLineCount(), ism.GetColCount());
+		}
+
+		return isNeg ?
+			// -(mag - 1) - 1 to avoid overflow when mag == negMax
+			(mag == 0 ?
+				ValType(0) :
+				static_cast<ValType>(-static_cast<ValType>(mag - 1) - 1)) :
+			static_cast<ValType>(mag);
+	}
+
+	/**
+	 * @brief Convert the digits to a 64-bit unsigned integer, where the
+	 *        digits are accumulated eight at a time, except the last digit
+	 *        that may overflow
+	 *
+	 * @exception ParseError thrown if the value doesn't fit in 64 bits
+	 */
+	static uint64_t DigitsToUInt64(
+		InputStateMachineIf<InputChType>& ism,
+		const InputChType* begin,
+		const InputChType* end)
+	{
+		// Max number of digits that won't overflow uint64_t
+		constexpr size_t maxDigits = std::numeric_limits<uint64_t>::digits10;
+
+		const size_t len = static_cast<size_t>(end - begin);
+		if (len > maxDigits + 1)
+		{
+			throw ParseError("The number is out of the range of the value type",
+				ism.GetLineCount(), ism.GetColCount());
+		}
+
+		uint64_t val = 0;
+		const InputChType* blockEnd = (len > maxDigits) ? (end - 1) : end;
+		for (; (blockEnd - begin) >= 8; begin += 8)
+		{
+			val = (val * 100000000ULL) +
+				Internal::EightDigitsToUInt(Internal::LoadEightChars(begin));
+		}
+		for (; begin != end; ++begin)
+		{
+			const uint64_t digit = static_cast<uint64_t>(*begin - '0');
+			if (val > ((std::numeric_limits<uint64_t>::max() - digit) / 10))
+			{
+				throw ParseError(
+					"The number is out of the range of the value type",
+					ism.GetLineCount(), ism.GetColCount());
+			}
+			val = (val * 10) + digit;
+		}
+
+		return val;
+	}
+
+}; // class NumArrayParserImpl
+
+} // namespace SimpleJson
@@ -0,0 +1,817 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <limits>
+#include <type_traits>
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Internal
+{
+
+/**
+ * @brief Implementation of the Grisu2 algorithm, which finds the shortest
+ *        (in almost all cases) decimal digits that round-trip to the same
+ *        floating point value.
+ *        Reference: Florian Loitsch, "Printing Floating-Point Numbers Quickly
+ *        and Accurately with Integers", PLDI 2010.
+ *
+ */
+namespace Grisu
+{
+
+/**
+ * @brief A "do it yourself" floating point number, `f * 2^e`
+ *
+ */
+struct DiyFp
+{
+	DiyFp(uint64_t f, int e) :
+		m_f(f),
+		m_e(e)
+	{}
+
+	/**
+	 * @brief x - y; both must have the same exponent, and x.f >= y.f
+	 *
+	 */
+	static DiyFp Sub(const DiyFp& x, const DiyFp& y)
+	{
+		return DiyFp(x.m_f - y.m_f, x.m_e);
+	}
+
+	/**
+	 * @brief x * y, where the result is rounded to 64 bits
+	 *
+	 */
+	static DiyFp Mul(const DiyFp& x, const DiyFp& y)
+	{
+		const uint64_t uLo = x.m_f & 0xFFFFFFFFULL;
+		const uint64_t uHi = x.m_f >> 32;
+		const uint64_t vLo = y.m_f & 0xFFFFFFFFULL;
+		const uint64_t vHi = y.m_f >> 32;
+
+		const uint64_t p0 = uLo * vLo;
+		const uint64_t p1 = uLo * vHi;
+		const uint64_t p2 = uHi * vLo;
+		const uint64_t p3 = uHi * vHi;
+
+		uint64_t q = (p0 >> 32) + (p1 & 0xFFFFFFFFULL) + (p2 & 0xFFFFFFFFULL);
+		q += (1ULL << 31); // round, ties up
+
+		const uint64_t h = p3 + (p1 >> 32) + (p2 >> 32) + (q >> 32);
+
+		return DiyFp(h, x.m_e + y.m_e + 64);
+	}
+
+	static DiyFp Normalize(DiyFp x)
+	{
+		while ((x.m_f >> 63) == 0)
+		{
+			x.m_f <<= 1;
+			--x.m_e;
+		}
+		return x;
+	}
+
+	static DiyFp NormalizeTo(const DiyFp& x, int targetExp)
+	{
+		return DiyFp(x.m_f << (x.m_e - targetExp), targetExp);
+	}
+
+	uint64_t m_f;
+	int m_e;
+
+}; // struct DiyFp
+
+/**
+ * @brief Compute the normalized value and its boundaries (m- and m+);
+ *        any number within the boundaries rounds to the value
+ *
+ * @param value must be finite and positive
+ */
+template<typename _FloatType>
+inline void ComputeBoundaries(_FloatType value,
+	DiyFp& w, DiyFp& wMinus, DiyFp& wPlus)
+{
+	// number of significand bits, including the hidden bit
+	constexpr int precision = std::numeric_limits<_FloatType>::digits;
+	constexpr int bias =
+		std::numeric_limits<_FloatType>::max_exponent - 1 + (precision - 1);
+	constexpr int minExp = 1 - bias;
+	constexpr uint64_t hiddenBit = 1ULL << (precision - 1);
+
+	using BitsType = typename std::conditional<
+		sizeof(_FloatType) == sizeof(uint32_t), uint32_t, uint64_t>::type;
+	static_assert(sizeof(_FloatType) == sizeof(BitsType),
+		"Only IEEE-754 single and double precision are supported");
+
+	BitsType rawBits = 0;
+	std::memcpy(&rawBits, &value, sizeof(rawBits));
+	const uint64_t bits = static_cast<uint64_t>(rawBits);
+
+	const uint64_t biasedExp = bits >> (precision - 1);
+	const uint64_t fraction = bits & (hiddenBit - 1);
+
+	const DiyFp v = (biasedExp == 0) ?
+		DiyFp(fraction, minExp) : // subnormal
+		DiyFp(fraction + hiddenBit, static_cast<int>(biasedExp) - bias);
+
+	// The lower boundary is closer if the value is a power of 2
+	const bool isLowerCloser = (fraction == 0) && (biasedExp > 1);
+
+	const DiyFp mPlus = DiyFp((v.m_f << 1) + 1, v.m_e - 1);
+	const DiyFp mMinus = isLowerCloser ?
+		DiyFp((v.m_f << 2) - 1, v.m_e - 2) :
+		DiyFp((v.m_f << 1) - 1, v.m_e - 1);
+
+	wPlus = DiyFp::Normalize(mPlus);
+	wMinus = DiyFp::NormalizeTo(mMinus, wPlus.m_e);
+	w = DiyFp::Normalize(v);
+}
+
+struct CachedPower
+{
+	uint64_t m_f;
+	int m_e;
+	int m_k;
+}; // struct CachedPower
+
+/**
+ * @brief Find a cached power of ten, `c = f * 2^e ~= 10^k`, such that the
+ *        binary exponent of `c * w` is in the range of [-60, -32], where `e`
+ *        is the binary exponent of `w`
+ *
+ */
+inline CachedPower GetCachedPower(int e)
+{
+	constexpr int alpha = -60;
+	constexpr int minDecExp = -300;
+	constexpr int decExpStep = 8;
+
+	// Normalized 10^k, for k = -300, -292, ..., 340, rounded to 64 bits
+	static constexpr CachedPower sk_cachedPowers[] = {
+		{ 0xAB70FE17C79AC6CAULL, -1060, -300 },
+		{ 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+		{ 0xBE5691EF416BD60CULL, -1007, -284 },
+		{ 0x8DD01FAD907FFC3CULL,  -980, -276 },
+		{ 0xD3515C2831559A83ULL,  -954, -268 },
+		{ 0x9D71AC8FADA6C9B5ULL,  -927, -260 },
+		{ 0xEA9C227723EE8BCBULL,  -901, -252 },
+		{ 0xAECC49914078536DULL,  -874, -244 },
+		{ 0x823C12795DB6CE57ULL,  -847, -236 },
+		{ 0xC21094364DFB5637ULL,  -821, -228 },
+		{ 0x9096EA6F3848984FULL,  -794, -220 },
+		{ 0xD77485CB25823AC7ULL,  -768, -212 },
+		{ 0xA086CFCD97BF97F4ULL,  -741, -204 },
+		{ 0xEF340A98172AACE5ULL,  -715, -196 },
+		{ 0xB23867FB2A35B28EULL,  -688, -188 },
+		{ 0x84C8D4DFD2C63F3BULL,  -661, -180 },
+		{ 0xC5DD44271AD3CDBAULL,  -635, -172 },
+		{ 0x936B9FCEBB25C996ULL,  -608, -164 },
+		{ 0xDBAC6C247D62A584ULL,  -582, -156 },
+		{ 0xA3AB66580D5FDAF6ULL,  -555, -148 },
+		{ 0xF3E2F893DEC3F126ULL,  -529, -140 },
+		{ 0xB5B5ADA8AAFF80B8ULL,  -502, -132 },
+		{ 0x87625F056C7C4A8BULL,  -475, -124 },
+		{ 0xC9BCFF6034C13053ULL,  -449, -116 },
+		{ 0x964E858C91BA2655ULL,  -422, -108 },
+		{ 0xDFF9772470297EBDULL,  -396, -100 },
+		{ 0xA6DFBD9FB8E5B88FULL,  -369,  -92 },
+		{ 0xF8A95FCF88747D94ULL,  -343,  -84 },
+		{ 0xB94470938FA89BCFULL,  -316,  -76 },
+		{ 0x8A08F0F8BF0F156BULL,  -289,  -68 },
+		{ 0xCDB02555653131B6ULL,  -263,  -60 },
+		{ 0x993FE2C6D07B7FACULL,  -236,  -52 },
+		{ 0xE45C10C42A2B3B06ULL,  -210,  -44 },
+		{ 0xAA242499697392D3ULL,  -183,  -36 },
+		{ 0xFD87B5F28300CA0EULL,  -157,  -28 },
+		{ 0xBCE5086492111AEBULL,  -130,  -20 },
+		{ 0x8CBCCC096F5088CCULL,  -103,  -12 },
+		{ 0xD1B71758E219652CULL,   -77,   -4 },
+		{ 0x9C40000000000000ULL,   -50,    4 },
+		{ 0xE8D4A51000000000ULL,   -24,   12 },
+		{ 0xAD78EBC5AC620000ULL,     3,   20 },
+		{ 0x813F3978F8940984ULL,    30,   28 },
+		{ 0xC097CE7BC90715B3ULL,    56,   36 },
+		{ 0x8F7E32CE7BEA5C70ULL,    83,   44 },
+		{ 0xD5D238A4ABE98068ULL,   109,   52 },
+		{ 0x9F4F2726179A2245ULL,   136,   60 },
+		{ 0xED63A231D4C4FB27ULL,   162,   68 },
+		{ 0xB0DE65388CC8ADA8ULL,   189,   76 },
+		{ 0x83C7088E1AAB65DBULL,   216,   84 },
+		{ 0xC45D1DF942711D9AULL,   242,   92 },
+		{ 0x924D692CA61BE758ULL,   269,  100 },
+		{ 0xDA01EE641A708DEAULL,   295,  108 },
+		{ 0xA26DA3999AEF774AULL,   322,  116 },
+		{ 0xF209787BB47D6B85ULL,   348,  124 },
+		{ 0xB454E4A179DD1877ULL,   375,  132 },
+		{ 0x865B86925B9BC5C2ULL,   402,  140 },
+		{ 0xC83553C5C8965D3DULL,   428,  148 },
+		{ 0x952AB45CFA97A0B3ULL,   455,  156 },
+		{ 0xDE469FBD99A05FE3ULL,   481,  164 },
+		{ 0xA59BC234DB398C25ULL,   508,  172 },
+		{ 0xF6C69A72A3989F5CULL,   534,  180 },
+		{ 0xB7DCBF5354E9BECEULL,   561,  188 },
+		{ 0x88FCF317F22241E2ULL,   588,  196 },
+		{ 0xCC20CE9BD35C78A5ULL,   614,  204 },
+		{ 0x98165AF37B2153DFULL,   641,  212 },
+		{ 0xE2A0B5DC971F303AULL,   667,  220 },
+		{ 0xA8D9D1535CE3B396ULL,   694,  228 },
+		{ 0xFB9B7CD9A4A7443CULL,   720,  236 },
+		{ 0xBB764C4CA7A44410ULL,   747,  244 },
+		{ 0x8BAB8EEFB6409C1AULL,   774,  252 },
+		{ 0xD01FEF10A657842CULL,   800,  260 },
+		{ 0x9B10A4E5E9913129ULL,   827,  268 },
+		{ 0xE7109BFBA19C0C9DULL,   853,  276 },
+		{ 0xAC2820D9623BF429ULL,   880,  284 },
+		{ 0x80444B5E7AA7CF85ULL,   907,  292 },
+		{ 0xBF21E44003ACDD2DULL,   933,  300 },
+		{ 0x8E679C2F5E44FF8FULL,   960,  308 },
+		{ 0xD433179D9C8CB841ULL,   986,  316 },
+		{ 0x9E19DB92B4E31BA9ULL,  1013,  324 },
+		{ 0xEB96BF6EBADF77D9ULL,  1039,  332 },
+		{ 0xAF87023B9BF0EE6BULL,  1066,  340 },
+	};
+
+	// k = ceil((alpha - e - 1) * log10(2))
+	const int f = alpha - e - 1;
+	const int k = ((f * 78913) / (1 << 18)) + static_cast<int>(f > 0);
+
+	const int idx = (-minDecExp + k + (decExpStep - 1)) / decExpStep;
+
+	return sk_cachedPowers[idx];
+}
+
+/**
+ * @brief Find the largest power of ten that is <= n, and return the number
+ *        of digits of n
+ *
+ */
+inline int FindLargestPow10(uint32_t n, uint32_t& pow10)
+{
+	if (n >= 1000000000) { pow10 = 1000000000; return 10; }
+	if (n >=  100000000) { pow10 =  100000000; return  9; }
+	if (n >=   10000000) { pow10 =   10000000; return  8; }
+	if (n >=    1000000) { pow10 =    1000000; return  7; }
+	if (n >=     100000) { pow10 =     100000; return  6; }
+	if (n >=      10000) { pow10 =      10000; return  5; }
+	if (n >=       1000) { pow10 =       1000; return  4; }
+	if (n >=        100) { pow10 =        100; return  3; }
+	if (n >=         10) { pow10 =         10; return  2; }
+
+	pow10 = 1;
+	return 1;
+}
+
+/**
+ * @brief Move the last digit closer to the exact value, as long as it's
+ *        still within the boundaries
+ *
+ */
+inline void Round(char* buf, int len,
+	uint64_t dist, uint64_t delta, uint64_t rest, uint64_t tenK)
+{
+	while ((rest < dist) &&
+		(delta - rest >= tenK) &&
+		((rest + tenK < dist) || (dist - rest > rest + tenK - dist)))
+	{
+		--buf[len - 1];
+		rest += tenK;
+	}
+}
+
+/**
+ * @brief Generate the shortest digits of `w` within the range of
+ *        (mMinus, mPlus)
+ *
+ */
+inline void GenDigits(char* buf, int& len, int& decExp,
+	const DiyFp& mMinus, const DiyFp& w, const DiyFp& mPlus)
+{
+	uint64_t delta = DiyFp::Sub(mPlus, mMinus).m_f;
+	uint64_t dist = DiyFp::Sub(mPlus, w).m_f;
+
+	const DiyFp one(1ULL << -mPlus.m_e, mPlus.m_e);
+
+	// integral part, which fits into 32 bits since -e >= 32
+	uint32_t p1 = static_cast<uint32_t>(mPlus.m_f >> -one.m_e);
+	// fractional part
+	uint64_t p2 = mPlus.m_f & (one.m_f - 1);
+
+	uint32_t pow10 = 0;
+	int n = FindLargestPow10(p1, pow10);
+
+	while (n > 0)
+	{
+		const uint32_t d = p1 / pow10;
+		p1 %= pow10;
+		buf[len++] = static_cast<char>('0' + d);
+		--n;
+
+		const uint64_t rest = (static_cast<uint64_t>(p1) << -one.m_e) + p2;
+		if (rest <= delta)
+		{
+			decExp += n;
+			Round(buf, len, dist, delta, rest,
+				static_cast<uint64_t>(pow10) << -one.m_e);
+			return;
+		}
+		pow10 /= 10;
+	}
+
+	int m = 0;
+	while (true)
+	{
+		p2 *= 10;
+		const uint64_t d = p2 >> -one.m_e;
+		p2 &= (one.m_f - 1);
+		buf[len++] = static_cast<char>('0' + d);
+		++m;
+
+		delta *= 10;
+		dist *= 10;
+		if (p2 <= delta)
+		{
+			break;
+		}
+	}
+
+	decExp -= m;
+	Round(buf, len, dist, delta, p2, one.m_f);
+}
+
+/**
+ * @brief Generate the digits of the given value, so that
+ *        `value == digits * 10^decExp`
+ *
+ * @param value must be finite and positive
+ * @param buf   must be able to hold at least 17 characters
+ */
+template<typename _FloatType>
+inline void Grisu2(char* buf, int& len, int& decExp, _FloatType value)
+{
+	DiyFp w(0, 0);
+	DiyFp wMinus(0, 0);
+	DiyFp wPlus(0, 0);
+	ComputeBoundaries(value, w, wMinus, wPlus);
+
+	const CachedPower cached = GetCachedPower(wPlus.m_e);
+	const DiyFp c(cached.m_f, cached.m_e);
+
+	const DiyFp cw = DiyFp::Mul(w, c);
+	const DiyFp cwMinus = DiyFp::Mul(wMinus, c);
+	const DiyFp cwPlus = DiyFp::Mul(wPlus, c);
+
+	// shrink the range by one unit, to be conservative
+	const DiyFp mMinus(cwMinus.m_f + 1, cwMinus.m_e);
+	const DiyFp mPlus(cwPlus.m_f - 1, cwPlus.m_e);
+
+	len = 0;
+	decExp = -cached.m_k;
+	GenDigits(buf, len, decExp, mMinus, cw, mPlus);
+}
+
+} // namespace Grisu
+
+/**
+ * @brief Write the exponent, in the form of `e[-]<digits>`
+ *
+ */
+inline char* FormatExponent(char* buf, int exp)
+{
+	*buf++ = 'e';
+	if (exp < 0)
+	{
+		*buf++ = '-';
+		exp = -exp;
+	}
+
+	if (exp >= 100)
+	{
+		*buf++ = static_cast<char>('0' + (exp / 100));
+		exp %= 100;
+		*buf++ = static_cast<char>('0' + (exp / 10));
+	}
+	else if (exp >= 10)
+	{
+		*buf++ = static_cast<char>('0' + (exp / 10));
+	}
+	*buf++ = static_cast<char>('0' + (exp % 10));
+
+	return buf;
+}
+
+/**
+ * @brief The maximum number of characters written by `FormatInt`
+ *        (e.g., `-9223372036854775808` or `18446744073709551615`)
+ *
+ */
+constexpr size_t sk_intFormatBufSize = 20;
+
+/**
+ * @brief Count the number of decimal digits of the given value
+ *
+ */
+inline size_t CountDigits(uint64_t val)
+{
+	size_t res = 1;
+	while (true)
+	{
+		// check four digits at a time
+		if (val <    10) { return res; }
+		if (val <   100) { return res + 1; }
+		if (val <  1000) { return res + 2; }
+		if (val < 10000) { return res + 3; }
+		val /= 10000;
+		res += 4;
+	}
+}
+
+/**
+ * @brief Write the decimal digits of the given value into the given buffer,
+ *        two digits at a time, without any allocation
+ *
+ * @param buf must be able to hold at least `sk_intFormatBufSize` characters
+ *
+ * @return the end of the written characters
+ */
+inline char* FormatUInt(char* buf, uint64_t val)
+{
+	static constexpr char sk_digitPairs[] =
+		"0001020304050607080910111213141516171819"
+		"2021222324252627282930313233343536373839"
+		"4041424344454647484950515253545556575859"
+		"6061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+
+	const size_t len = CountDigits(val);
+	char* end = buf + len;
+	char* ptr = end;
+
+	while (val >= 100)
+	{
+		const size_t idx = static_cast<size_t>(val % 100) * 2;
+		val /= 100;
+		*--ptr = sk_digitPairs[idx + 1];
+		*--ptr = sk_digitPairs[idx];
+	}
+
+	if (val >= 10)
+	{
+		const size_t idx = static_cast<size_t>(val) * 2;
+		*--ptr = sk_digitPairs[idx + 1];
+		*--ptr = sk_digitPairs[idx];
+	}
+	else
+	{
+		*--ptr = static_cast<char>('0' + val);
+	}
+
+	return end;
+}
+
+/**
+ * @brief Write the given signed value into the given buffer, without any
+ *        allocation
+ *
+ * @param buf must be able to hold at least `sk_intFormatBufSize` characters
+ *
+ * @return the end of the written characters
+ */
+inline char* FormatInt(char* buf, int64_t val)
+{
+	uint64_t absVal = static_cast<uint64_t>(val);
+	if (val < 0)
+	{
+		*buf++ = '-';
+		// well-defined even for the minimum value
+		absVal = 0 - absVal;
+	}
+	return FormatUInt(buf, absVal);
+}
+
+/**
+ * @brief The maximum number of characters written by `FormatReal`
+ *
+ */
+constexpr size_t sk_realFormatBufSize = 32;
+
+/**
+ * @brief Write the shortest representation of the given floating point
+ *        value that round-trips, into the given buffer, without any
+ *        allocation; the format is fixed and locale-independent:
+ *        - `[-]digits.0`, `[-]dig.its`, or `[-]0.000digits`, if the decimal
+ *          exponent is within a reasonable range
+ *        - `[-]d[.igits]e[-]exp`, otherwise
+ *
+ * @param value must be finite
+ * @param buf   must be able to hold at least `sk_realFormatBufSize`
+ *              characters
+ *
+ * @return the end of the written characters
+ */
+template<typename _FloatType>
+inline char* FormatReal(char* buf, _FloatType value)
+{
+	// the range of decimal point positions for the fixed notation
+	constexpr int minExp = -4;
+	constexpr int maxExp = std::numeric_limits<_FloatType>::digits10;
+
+	if (std::signbit(value))
+	{
+		*buf++ = '-';
+		value = -value;
+	}
+
+	if (value == 0)
+	{
+		*buf++ = '0';
+		*buf++ = '.';
+		*buf++ = '0';
+		return buf;
+	}
+
+	int len = 0;
+	int decExp = 0;
+	Grisu::Grisu2(buf, len, decExp, value);
+
+	// value = digits * 10^(n - len); n is the position of the decimal point
+	const int n = len + decExp;
+
+	if (len <= n && n <= maxExp)
+	{
+		// digits[000].0
+		std::memset(buf + len, '0', static_cast<size_t>(n - len));
+		buf[n] = '.';
+		buf[n + 1] = '0';
+		return buf + (n + 2);
+	}
+
+	if (0 < n && n <= maxExp)
+	{
+		// dig.its
+		std::memmove(buf + (n + 1), buf + n, static_cast<size_t>(len - n));
+		buf[n] = '.';
+		return buf + (len + 1);
+	}
+
+	if (minExp < n && n <= 0)
+	{
+		// 0.[000]digits
+		std::memmove(buf + (2 - n), buf, static_cast<size_t>(len));
+		buf[0] = '0';
+		buf[1] = '.';
+		std::memset(buf + 2, '0', static_cast<size_t>(-n));
+		return buf + (2 - n + len);
+	}
+
+	if (len == 1)
+	{
+		// de[-]exp
+		buf += 1;
+	}
+	else
+	{
+		// d.igitse[-]exp
+		std::memmove(buf + 2, buf + 1, static_cast<size_t>(len - 1));
+		buf[1] = '.';
+		buf += (len + 1);
+	}
+
+	return FormatExponent(buf, n - 1);
+}
+
+/**
+ * @brief Check if `digits * 10^decExp` is parsed back to the given value
+ *
+ */
+inline bool DigitsRoundTrip(
+	const char* digits, int len, int decExp, double value)
+{
+	// no decimal point, so it's not affected by the locale
+	char tmp[sk_realFormatBufSize];
+	std::memcpy(tmp, digits, static_cast<size_t>(len));
+	char* end = FormatExponent(tmp + len, decExp);
+	*end = '\0';
+
+	return std::strtod(tmp, nullptr) == value;
+}
+
+/**
+ * @brief Drop the trailing digits generated by `Grisu2`, as long as the
+ *        shorter number still round-trips.
+ *        `Grisu2` occasionally generates one more digit than needed, which
+ *        is harmless in general, but not acceptable when the output must be
+ *        canonical. Each step is verified with `strtod`, so this costs much
+ *        more than `Grisu2` itself.
+ *        When both shorter candidates round-trip, the one closer to the
+ *        original digits is taken
+ *
+ * @param buf must be able to hold at least 17 characters
+ */
+inline void ShortenDigits(char* buf, int& len, int& decExp, double value)
+{
+	while (len > 1)
+	{
+		const int downLen = len - 1;
+		const int downExp = decExp + 1;
+		const bool preferUp = (buf[downLen] >= '5');
+
+		// round up the digits, and drop the trailing zeros
+		char up[17];
+		std::memcpy(up, buf, static_cast<size_t>(downLen));
+		int upLen = downLen;
+		while (upLen > 0 && up[upLen - 1] == '9')
+		{
+			--upLen;
+		}
+		int upExp = downExp + (downLen - upLen);
+		if (upLen == 0)
+		{
+			// 99..9 -> 1
+			up[0] = '1';
+			upLen = 1;
+		}
+		else
+		{
+			++(up[upLen - 1]);
+		}
+
+		const bool isUpOk = DigitsRoundTrip(up, upLen, upExp, value);
+		if (isUpOk && preferUp)
+		{
+			std::memcpy(buf, up, static_cast<size_t>(upLen));
+			len = upLen;
+			decExp = upExp;
+		}
+		else if (DigitsRoundTrip(buf, downLen, downExp, value))
+		{
+			len = downLen;
+			decExp = downExp;
+		}
+		else if (isUpOk)
+		{
+			std::memcpy(buf, up, static_cast<size_t>(upLen));
+			len = upLen;
+			decExp = upExp;
+		}
+		else
+		{
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Replace the digits with the ones closest to the value, at the same
+ *        length.
+ *        With 16 or 17 digits, more than one candidate may round-trip, and
+ *        `Grisu2` doesn't always pick the closest one, so the correctly
+ *        rounded digits are taken from `snprintf`
+ *
+ * @param buf must be able to hold at least 17 characters
+ */
+inline void NearestDigits(char* buf, int& len, int& decExp, double value)
+{
+	char tmp[sk_realFormatBufSize];
+	std::snprintf(tmp, sizeof(tmp), "%.*e", len - 1, value);
+
+	// d<point>ddde(+|-)xx; the decimal point depends on the locale
+	const char* ptr = tmp;
+	int newLen = 0;
+	for (; *ptr != 'e'; ++ptr)
+	{
+		if ('0' <= *ptr && *ptr <= '9')
+		{
+			buf[newLen++] = *ptr;
+		}
+	}
+	const int exp = static_cast<int>(std::strtol(ptr + 1, nullptr, 10));
+
+	len = newLen;
+	decExp = exp - (newLen - 1);
+	while (len > 1 && buf[len - 1] == '0')
+	{
+		--len;
+		++decExp;
+	}
+}
+
+/**
+ * @brief The maximum number of characters written by `FormatEcmaNumber`
+ *
+ */
+constexpr size_t sk_ecmaFormatBufSize = 32;
+
+/**
+ * @brief Write the given value in the format of ECMAScript's
+ *        `Number.prototype.toString` (e.g., `1`, `0.5`, `1e+21`, `1e-7`),
+ *        which is required by RFC 8785 (JSON Canonicalization Scheme);
+ *        unlike `FormatReal`, the digits are guaranteed to be the shortest
+ *
+ * @param value must be finite
+ * @param buf   must be able to hold at least `sk_ecmaFormatBufSize`
+ *              characters
+ *
+ * @return the end of the written characters
+ */
+inline char* FormatEcmaNumber(char* buf, double value)
+{
+	// the range of decimal point positions for the fixed notation
+	constexpr int minExp = -6;
+	constexpr int maxExp = 21;
+
+	if (value == 0)
+	{
+		// including -0
+		*buf++ = '0';
+		return buf;
+	}
+
+	if (value < 0)
+	{
+		*buf++ = '-';
+		value = -value;
+	}
+
+	int len = 0;
+	int decExp = 0;
+	Grisu::Grisu2(buf, len, decExp, value);
+	ShortenDigits(buf, len, decExp, value);
+	if (len >= 16)
+	{
+		NearestDigits(buf, len, decExp, value);
+	}
+
+	// value = digits * 10^(n - len); n is the position of the decimal point
+	const int n = len + decExp;
+
+	if (len <= n && n <= maxExp)
+	{
+		// digits[000]
+		std::memset(buf + len, '0', static_cast<size_t>(n - len));
+		return buf + n;
+	}
+
+	if (0 < n && n <= maxExp)
+	{
+		// dig.its
+		std::memmove(buf + (n + 1), buf + n, static_cast<size_t>(len - n));
+		buf[n] = '.';
+		return buf + (len + 1);
+	}
+
+	if (minExp < n && n <= 0)
+	{
+		// 0.[000]digits
+		std::memmove(buf + (2 - n), buf, static_cast<size_t>(len));
+		buf[0] = '0';
+		buf[1] = '.';
+		std::memset(buf + 2, '0', static_cast<size_t>(-n));
+		return buf + (2 - n + len);
+	}
+
+	if (len == 1)
+	{
+		// de(+|-)exp
+		buf += 1;
+	}
+	else
+	{
+		// d.igitse(+|-)exp
+		std::memmove(buf + 2, buf + 1, static_cast<size_t>(len - 1));
+		buf[1] = '.';
+		buf += (len + 1);
+	}
+
+	int exp = n - 1;
+	*buf++ = 'e';
+	if (exp < 0)
+	{
+		*buf++ = '-';
+		exp = -exp;
+	}
+	else
+	{
+		*buf++ = '+';
+	}
+	return FormatUInt(buf, static_cast<uint64_t>(exp));
+}
+
+} // namespace Internal
+} // namespace SimpleJson
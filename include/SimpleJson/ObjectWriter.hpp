@@ -5,9 +5,16 @@
 
 #pragma once
 
+#include <iterator>
+#include <string>
+#include <utility>
+
 #include "Internal/SimpleObjects.hpp"
 
+#include "BytesWriter.hpp"
 #include "Exceptions.hpp"
+#include "OutputSink.hpp"
+#include "SerializeCache.hpp"
 #include "WriterConfig.hpp"
 
 #ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
@@ -29,6 +36,7 @@ struct JsonWriterKeyImpl
 	using NullWriter = _NullWriter;
 	using NumWriter = _NumWriter;
 	using StrWriter = _StrWriter;
+	using BytesWriter = JsonWriterBytesImpl<_ToStringType>;
 
 	template<typename _OutputIt>
 	inline static void Write(_OutputIt destIt,
@@ -53,6 +61,9 @@ struct JsonWriterKeyImpl
 		case Internal::Obj::ObjCategory::String:
 			StrWriter::Write(destIt, obj.AsString(), config, state);
 			break;
+		case Internal::Obj::ObjCategory::Bytes:
+			BytesWriter::Write(destIt, obj.AsBytes(), config, state);
+			break;
 		default:
 			throw SerializeTypeError(obj.GetCategoryName());
 		}
@@ -66,7 +77,8 @@ template<
 	typename _StrWriter,
 	typename _KeyWriter,
 	typename _ToStringType,
-	typename _ContainerType>
+	typename _ContainerType,
+	typename _Policy = PrettyWriterPolicy>
 struct JsonWriterObjectImpl
 {
 
@@ -77,24 +89,74 @@ struct JsonWriterObjectImpl
 			_StrWriter,
 			_KeyWriter,
 			_ToStringType,
-			_ContainerType>;
+			_ContainerType,
+			_Policy>;
 
 	using NullWriter = _NullWriter;
 	using NumWriter  = _NumWriter;
 	using StrWriter  = _StrWriter;
+	using BytesWriter = JsonWriterBytesImpl<_ToStringType>;
 	using ListWriter =
-		JsonWriterListImpl<Self, _ToStringType, _ContainerType>;
+		JsonWriterListImpl<Self, _ToStringType, _ContainerType, _Policy>;
 	using KeyWriter  = _KeyWriter;
 	using DictWriter =
-		JsonWriterDictImpl<KeyWriter, Self, _ToStringType, _ContainerType>;
+		JsonWriterDictImpl<
+			KeyWriter, Self, _ToStringType, _ContainerType, _Policy>;
 	using StaticDictWriter =
-		JsonWriterStaticDictImpl<KeyWriter, Self, _ToStringType, _ContainerType>;
+		JsonWriterStaticDictImpl<
+			KeyWriter, Self, _ToStringType, _ContainerType, _Policy>;
 
 	template<typename _OutputIt>
 	inline static void Write(_OutputIt destIt,
 		const Internal::Obj::BaseObject<_ToStringType>& obj,
 		const WriterConfig& config,
 		const WriterStates& state)
+	{
+		if ((state.m_serializeCache != nullptr) &&
+			state.m_serializeCache->IsMarked(&obj))
+		{
+			WriteCached(destIt, obj, config, state);
+		}
+		else
+		{
+			WriteObject(destIt, obj, config, state);
+		}
+	}
+
+	/**
+	 * @brief Copy the cached bytes of the marked subtree, or serialize it
+	 *        and cache the bytes, if they are not cached yet
+	 *
+	 */
+	template<typename _OutputIt>
+	inline static void WriteCached(_OutputIt destIt,
+		const Internal::Obj::BaseObject<_ToStringType>& obj,
+		const WriterConfig& config,
+		const WriterStates& state)
+	{
+		SerializeCache& cache = *(state.m_serializeCache);
+		const bool isPretty = _Policy::IsPretty(config);
+
+		const std::string* cached =
+			cache.Find(&obj, config, isPretty, state.m_nestLevel);
+		if (cached != nullptr)
+		{
+			Internal::WriteChars(destIt, cached->data(), cached->size());
+			return;
+		}
+
+		std::string bytes;
+		WriteObject(std::back_inserter(bytes), obj, config, state);
+		Internal::WriteChars(destIt, bytes.data(), bytes.size());
+
+		cache.Put(&obj, config, isPretty, state.m_nestLevel, std::move(bytes));
+	}
+
+	template<typename _OutputIt>
+	inline static void WriteObject(_OutputIt destIt,
+		const Internal::Obj::BaseObject<_ToStringType>& obj,
+		const WriterConfig& config,
+		const WriterStates& state)
 	{
 		switch(obj.GetCategory())
 		{
@@ -118,6 +180,9 @@ struct JsonWriterObjectImpl
 		case Internal::Obj::ObjCategory::StaticDict:
 			StaticDictWriter::Write(destIt, obj.AsStaticDict(), config, state);
 			break;
+		case Internal::Obj::ObjCategory::Bytes:
+			BytesWriter::Write(destIt, obj.AsBytes(), config, state);
+			break;
 		default:
 			throw SerializeTypeError(obj.GetCategoryName());
 		}
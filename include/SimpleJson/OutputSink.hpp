@@ -0,0 +1,619 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+
+#include <sys/uio.h>
+#include <unistd.h>
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#include "Exceptions.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief The base class of all output sinks. Characters are gathered in an
+ *        internal buffer, and handed to the underlying destination in blocks,
+ *        so the destination is not touched for every single character.
+ *        NOTE: `Flush` must be called before the destination is accessed
+ *
+ * @tparam _CharType The type of characters accepted by the sink
+ */
+template<typename _CharType>
+class OutputSinkBase
+{
+public: // static members:
+
+	using value_type = _CharType;
+
+	static constexpr size_t sk_bufSize = 4096;
+
+public:
+
+	OutputSinkBase() :
+		m_pos(0)
+	{}
+
+	OutputSinkBase(const OutputSinkBase& other) = delete;
+
+	// LCOV_EXCL_START
+	virtual ~OutputSinkBase() = default;
+	// LCOV_EXCL_STOP
+
+	OutputSinkBase& operator=(const OutputSinkBase& other) = delete;
+
+	void Put(value_type ch)
+	{
+		if (m_pos == sk_bufSize)
+		{
+			Flush();
+		}
+		m_buf[m_pos++] = ch;
+	}
+
+	void Write(const value_type* data, size_t size)
+	{
+		if (size > (sk_bufSize - m_pos))
+		{
+			if (size >= sk_bufSize)
+			{
+				// too large to be buffered; hand it over directly,
+				// together with what's in the buffer
+				DrainPair(m_buf, m_pos, data, size);
+				m_pos = 0;
+				return;
+			}
+			Flush();
+		}
+		std::copy(data, data + size, m_buf + m_pos);
+		m_pos += size;
+	}
+
+	/**
+	 * @brief Hand all the buffered characters to the destination
+	 *
+	 */
+	void Flush()
+	{
+		if (m_pos > 0)
+		{
+			Drain(m_buf, m_pos);
+			m_pos = 0;
+		}
+	}
+
+protected:
+
+	/**
+	 * @brief Write a block of characters to the underlying destination
+	 *
+	 */
+	virtual void Drain(const value_type* data, size_t size) = 0;
+
+	/**
+	 * @brief Write two blocks of characters, in order, to the underlying
+	 *        destination; destinations supporting gather writes can
+	 *        override this to write both blocks at once
+	 *
+	 */
+	virtual void DrainPair(
+		const value_type* data1, size_t size1,
+		const value_type* data2, size_t size2)
+	{
+		if (size1 > 0)
+		{
+			Drain(data1, size1);
+		}
+		Drain(data2, size2);
+	}
+
+private:
+
+	value_type m_buf[sk_bufSize];
+	size_t m_pos;
+
+}; // class OutputSinkBase
+
+template<typename _CharType>
+constexpr size_t OutputSinkBase<_CharType>::sk_bufSize;
+
+/**
+ * @brief Output sink that appends everything to a string
+ *
+ * @tparam _StringType The type of the destination string
+ */
+template<typename _StringType>
+class StringOutputSinkImpl :
+	public OutputSinkBase<typename _StringType::value_type>
+{
+public: // static members:
+
+	using Base = OutputSinkBase<typename _StringType::value_type>;
+	using StringType = _StringType;
+	using value_type = typename Base::value_type;
+
+public:
+
+	explicit StringOutputSinkImpl(StringType& dest) :
+		Base(),
+		m_dest(dest)
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~StringOutputSinkImpl() = default;
+	// LCOV_EXCL_STOP
+
+protected:
+
+	virtual void Drain(const value_type* data, size_t size) override
+	{
+		m_dest.append(data, size);
+	}
+
+private:
+
+	StringType& m_dest;
+
+}; // class StringOutputSinkImpl
+
+/**
+ * @brief Output sink that writes to a `std::ostream`; errors are reported
+ *        through the state of the stream, as usual
+ *
+ */
+class StreamOutputSink : public OutputSinkBase<char>
+{
+public: // static members:
+
+	using Base = OutputSinkBase<char>;
+
+public:
+
+	explicit StreamOutputSink(std::ostream& dest) :
+		Base(),
+		m_dest(dest)
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~StreamOutputSink() = default;
+	// LCOV_EXCL_STOP
+
+protected:
+
+	virtual void Drain(const char* data, size_t size) override
+	{
+		m_dest.write(data, static_cast<std::streamsize>(size));
+	}
+
+private:
+
+	std::ostream& m_dest;
+
+}; // class StreamOutputSink
+
+/**
+ * @brief Output sink that writes to a C `FILE` stream
+ *
+ */
+class FileOutputSink : public OutputSinkBase<char>
+{
+public: // static members:
+
+	using Base = OutputSinkBase<char>;
+
+public:
+
+	explicit FileOutputSink(std::FILE* dest) :
+		Base(),
+		m_dest(dest)
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~FileOutputSink() = default;
+	// LCOV_EXCL_STOP
+
+protected:
+
+	virtual void Drain(const char* data, size_t size) override
+	{
+		if (std::fwrite(data, 1, size, m_dest) != size)
+		{
+			throw Exception("Failed to write to the file stream");
+		}
+	}
+
+private:
+
+	std::FILE* m_dest;
+
+}; // class FileOutputSink
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/**
+ * @brief Output sink that writes to a POSIX file descriptor (e.g., a file,
+ *        a pipe, or a socket) with `write`/`writev`
+ *
+ */
+class FdOutputSink : public OutputSinkBase<char>
+{
+public: // static members:
+
+	using Base = OutputSinkBase<char>;
+
+public:
+
+	explicit FdOutputSink(int fd) :
+		Base(),
+		m_fd(fd)
+	{}
+
+	// LCOV_EXCL_START
+	virtual ~FdOutputSink() = default;
+	// LCOV_EXCL_STOP
+
+protected:
+
+	virtual void Drain(const char* data, size_t size) override
+	{
+		while (size > 0)
+		{
+			const ssize_t res = ::write(m_fd, data, size);
+			if (res < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				throw Exception("Failed to write to the file descriptor");
+			}
+			data += res;
+			size -= static_cast<size_t>(res);
+		}
+	}
+
+	virtual void DrainPair(
+		const char* data1, size_t size1,
+		const char* data2, size_t size2) override
+	{
+		struct iovec iov[2];
+		iov[0].iov_base = const_cast<char*>(data1);
+		iov[0].iov_len = size1;
+		iov[1].iov_base = const_cast<char*>(data2);
+		iov[1].iov_len = size2;
+
+		ssize_t res = 0;
+		do
+		{
+			res = ::writev(m_fd, iov, 2);
+		} while (res < 0 && errno == EINTR);
+
+		if (res < 0)
+		{
+			throw Exception("Failed to write to the file descriptor");
+		}
+
+		// finish the rest, in case of a partial write
+		size_t written = static_cast<size_t>(res);
+		if (written < size1)
+		{
+			Drain(data1 + written, size1 - written);
+			written = size1;
+		}
+		Drain(data2 + (written - size1), size2 - (written - size1));
+	}
+
+private:
+
+	int m_fd;
+
+}; // class FdOutputSink
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+/**
+ * @brief Output iterator that puts characters into an output sink, so it
+ *        can be used by all writers; copies of the iterator refer to the
+ *        same sink
+ *
+ * @tparam _CharType The type of characters accepted by the sink
+ */
+template<typename _CharType>
+class OutputSinkIterator
+{
+public: // static members:
+
+	using iterator_category = std::output_iterator_tag;
+	using value_type        = void;
+	using difference_type   = std::ptrdiff_t;
+	using pointer           = void;
+	using reference         = void;
+
+	using SinkType = OutputSinkBase<_CharType>;
+
+public:
+
+	explicit OutputSinkIterator(SinkType& sink) :
+		m_sink(&sink)
+	{}
+
+	~OutputSinkIterator() = default;
+
+	OutputSinkIterator& operator=(_CharType ch)
+	{
+		m_sink->Put(ch);
+		return *this;
+	}
+
+	OutputSinkIterator& operator*()
+	{
+		return *this;
+	}
+
+	OutputSinkIterator& operator++()
+	{
+		return *this;
+	}
+
+	OutputSinkIterator& operator++(int)
+	{
+		return *this;
+	}
+
+	SinkType& GetSink() const
+	{
+		return *m_sink;
+	}
+
+private:
+
+	SinkType* m_sink;
+
+}; // class OutputSinkIterator
+
+/**
+ * @brief Output iterator that discards all characters, and only counts how
+ *        many of them have been written; copies of the iterator share the
+ *        same counter
+ *
+ */
+class CountingOutputIterator
+{
+public: // static members:
+
+	using iterator_category = std::output_iterator_tag;
+	using value_type        = void;
+	using difference_type   = std::ptrdiff_t;
+	using pointer           = void;
+	using reference         = void;
+
+public:
+
+	explicit CountingOutputIterator(size_t& count) :
+		m_count(&count)
+	{}
+
+	~CountingOutputIterator() = default;
+
+	template<typename _CharType>
+	CountingOutputIterator& operator=(const _CharType&)
+	{
+		++(*m_count);
+		return *this;
+	}
+
+	CountingOutputIterator& operator*()
+	{
+		return *this;
+	}
+
+	CountingOutputIterator& operator++()
+	{
+		return *this;
+	}
+
+	CountingOutputIterator& operator++(int)
+	{
+		return *this;
+	}
+
+	void Add(size_t size) const
+	{
+		(*m_count) += size;
+	}
+
+private:
+
+	size_t* m_count;
+
+}; // class CountingOutputIterator
+
+/**
+ * @brief A caller-provided buffer of fixed capacity; characters beyond the
+ *        capacity are dropped, but still counted, so the size required to
+ *        hold the whole output is known at the end.
+ *        It never allocates any memory by itself.
+ *
+ */
+class FixedBuffer
+{
+public:
+
+	FixedBuffer(char* buf, size_t capacity) :
+		m_buf(buf),
+		m_capacity(capacity),
+		m_size(0)
+	{}
+
+	FixedBuffer(const FixedBuffer& other) = delete;
+
+	~FixedBuffer() = default;
+
+	FixedBuffer& operator=(const FixedBuffer& other) = delete;
+
+	void Put(char ch)
+	{
+		if (m_size < m_capacity)
+		{
+			m_buf[m_size] = ch;
+		}
+		++m_size;
+	}
+
+	void Write(const char* data, size_t size)
+	{
+		if (m_size < m_capacity)
+		{
+			const size_t copySize = std::min(size, m_capacity - m_size);
+			std::copy(data, data + copySize, m_buf + m_size);
+		}
+		m_size += size;
+	}
+
+	/**
+	 * @brief Get the number of characters written so far, including the
+	 *        ones dropped
+	 *
+	 */
+	size_t GetSize() const
+	{
+		return m_size;
+	}
+
+	size_t GetCapacity() const
+	{
+		return m_capacity;
+	}
+
+	bool IsOverflow() const
+	{
+		return m_size > m_capacity;
+	}
+
+private:
+
+	char* m_buf;
+	size_t m_capacity;
+	size_t m_size;
+
+}; // class FixedBuffer
+
+/**
+ * @brief Output iterator that puts characters into a fixed buffer; copies of
+ *        the iterator refer to the same buffer
+ *
+ */
+class FixedBufferIterator
+{
+public: // static members:
+
+	using iterator_category = std::output_iterator_tag;
+	using value_type        = void;
+	using difference_type   = std::ptrdiff_t;
+	using pointer           = void;
+	using reference         = void;
+
+public:
+
+	explicit FixedBufferIterator(FixedBuffer& buf) :
+		m_buf(&buf)
+	{}
+
+	~FixedBufferIterator() = default;
+
+	FixedBufferIterator& operator=(char ch)
+	{
+		m_buf->Put(ch);
+		return *this;
+	}
+
+	FixedBufferIterator& operator*()
+	{
+		return *this;
+	}
+
+	FixedBufferIterator& operator++()
+	{
+		return *this;
+	}
+
+	FixedBufferIterator& operator++(int)
+	{
+		return *this;
+	}
+
+	FixedBuffer& GetBuffer() const
+	{
+		return *m_buf;
+	}
+
+private:
+
+	FixedBuffer* m_buf;
+
+}; // class FixedBufferIterator
+
+namespace Internal
+{
+
+/**
+ * @brief Write a block of characters to the output iterator
+ *
+ */
+template<typename _OutIt, typename _CharType>
+inline void WriteChars(_OutIt out, const _CharType* data, size_t size)
+{
+	std::copy(data, data + size, out);
+}
+
+/**
+ * @brief Write a block of characters to the output sink in bulk
+ *
+ */
+template<typename _CharType>
+inline void WriteChars(
+	OutputSinkIterator<_CharType> out, const _CharType* data, size_t size)
+{
+	out.GetSink().Write(data, size);
+}
+
+/**
+ * @brief Only count the size of the block
+ *
+ */
+template<typename _CharType>
+inline void WriteChars(
+	CountingOutputIterator out, const _CharType*, size_t size)
+{
+	out.Add(size);
+}
+
+/**
+ * @brief Write a block of characters to the fixed buffer in bulk
+ *
+ */
+inline void WriteChars(FixedBufferIterator out, const char* data, size_t size)
+{
+	out.GetBuffer().Write(data, size);
+}
+
+} // namespace Internal
+
+} // namespace SimpleJson
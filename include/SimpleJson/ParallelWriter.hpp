@@ -0,0 +1,456 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "Internal/SimpleObjects.hpp"
+
+#include "DictWriter.hpp"
+#include "OutputSink.hpp"
+#include "Utils.hpp"
+#include "WriterConfig.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief Writer that serializes large lists and dicts on multiple threads.
+ *        Large containers (at least `2 * minChunkSize` items), either at the
+ *        top level or nested, are split into chunks of items; each chunk,
+ *        as well as each mid-sized subtree, is serialized into its own
+ *        buffer by a pool of worker threads, and the buffers are then
+ *        written out in order. The output is byte-identical to the one of
+ *        `_ObjWriter`, including the indentation in the pretty mode.
+ *        NOTE: `WriterStates::m_serializeCache` is not thread-safe, so it's
+ *        not used by this writer
+ *
+ * @tparam _KeyWriter The writer for dict keys, same as the one in `_ObjWriter`
+ * @tparam _ObjWriter The writer for each item
+ * @tparam _Policy    The policy used by `_ObjWriter`
+ */
+template<
+	typename _KeyWriter,
+	typename _ObjWriter,
+	typename _ToStringType,
+	typename _Policy = PrettyWriterPolicy>
+struct JsonWriterParallelImpl
+{
+
+	using ObjType = Internal::Obj::BaseObject<_ToStringType>;
+	using KeyType = Internal::Obj::HashableBaseObject<_ToStringType>;
+	using DictTraits = DynamicDictTraits<_ToStringType>;
+
+	static constexpr size_t sk_defaultMinChunkSize = 1024;
+
+	/**
+	 * @brief An item in a container; `m_key` is null for list items
+	 *
+	 */
+	struct Item
+	{
+		const KeyType* m_key;
+		const ObjType* m_val;
+	}; // struct Item
+
+	/**
+	 * @brief A piece of the output; either the text written by the planner,
+	 *        or a job to be done by workers
+	 *
+	 */
+	struct Segment
+	{
+		enum class Kind
+		{
+			Text,
+			Items,
+			Whole,
+		}; // enum class Kind
+
+		explicit Segment(Kind kind) :
+			m_kind(kind),
+			m_obj(nullptr),
+			m_items(nullptr),
+			m_begin(0),
+			m_end(0),
+			m_nestLevel(0),
+			m_text(),
+			m_error()
+		{}
+
+		Kind m_kind;
+
+		// Whole: the subtree to write
+		const ObjType* m_obj;
+
+		// Items: items in [m_begin, m_end) of a container
+		const std::vector<Item>* m_items;
+		size_t m_begin;
+		size_t m_end;
+
+		size_t m_nestLevel;
+
+		std::string m_text;
+		std::exception_ptr m_error;
+	}; // struct Segment
+
+	struct Context
+	{
+		Context(
+			const WriterConfig& config,
+			size_t numThreads,
+			size_t minChunkSize) :
+			m_config(config),
+			m_numThreads(numThreads),
+			m_minChunkSize(std::max<size_t>(minChunkSize, 1)),
+			m_newLineCache(),
+			m_itemLists(),
+			m_segments()
+		{}
+
+		const WriterConfig& m_config;
+		size_t m_numThreads;
+		size_t m_minChunkSize;
+
+		std::string m_newLineCache;
+		// items of split containers; a list keeps them at stable addresses
+		std::list<std::vector<Item> > m_itemLists;
+		std::vector<Segment> m_segments;
+	}; // struct Context
+
+	template<typename _OutputIt>
+	inline static void WriteNewLine(_OutputIt destIt,
+		const WriterConfig& config,
+		std::string& newLineCache,
+		size_t nestLevel)
+	{
+		WriterStates state;
+		state.m_nestLevel = nestLevel;
+		state.m_newLineCache = &newLineCache;
+		Internal::WriteNewLine(destIt, config, state, nestLevel);
+	}
+
+	/**
+	 * @brief Write what comes before the `idx`-th item of a container, at the
+	 *        given nesting level of items
+	 *
+	 */
+	template<typename _OutputIt>
+	inline static void WriteItemPrefix(_OutputIt destIt,
+		const WriterConfig& config,
+		std::string& newLineCache,
+		size_t nestLevel,
+		size_t idx,
+		const KeyType* key)
+	{
+		if (idx != 0)
+		{
+			*destIt++ = ',';
+		}
+		if (_Policy::IsPretty(config))
+		{
+			WriteNewLine(destIt, config, newLineCache, nestLevel);
+		}
+		if (key != nullptr)
+		{
+			WriterStates state;
+			state.m_nestLevel = nestLevel;
+			state.m_newLineCache = &newLineCache;
+			_KeyWriter::Write(destIt, *key, config, state);
+
+			if (_Policy::IsPretty(config))
+			{
+				Internal::WriteChars(destIt, " : ", 3);
+			}
+			else
+			{
+				*destIt++ = ':';
+			}
+		}
+	}
+
+	template<typename _OutputIt>
+	inline static void WriteValue(_OutputIt destIt,
+		const WriterConfig& config,
+		std::string& newLineCache,
+		size_t nestLevel,
+		const ObjType& obj)
+	{
+		WriterStates state;
+		state.m_nestLevel = nestLevel;
+		state.m_newLineCache = &newLineCache;
+		_ObjWriter::Write(destIt, obj, config, state);
+	}
+
+	inline static bool IsSplittable(const ObjType& obj)
+	{
+		return obj.GetCategory() == Internal::Obj::ObjCategory::List ||
+			obj.GetCategory() == Internal::Obj::ObjCategory::Dict;
+	}
+
+	inline static std::vector<Item> GetItems(const ObjType& obj)
+	{
+		std::vector<Item> items;
+		if (obj.GetCategory() == Internal::Obj::ObjCategory::List)
+		{
+			const auto& list = obj.AsList();
+			items.reserve(list.size());
+			for (auto it = list.cbegin(); it != list.cend(); ++it)
+			{
+				Item item;
+				item.m_key = nullptr;
+				item.m_val = &(*it);
+				items.push_back(item);
+			}
+		}
+		else
+		{
+			const auto& dict = obj.AsDict();
+			items.reserve(dict.size());
+			for (auto it = dict.cbegin(); it != dict.cend(); ++it)
+			{
+				Item item;
+				item.m_key = &(DictTraits::GetKey(*it));
+				item.m_val = &(DictTraits::GetVal(*it));
+				items.push_back(item);
+			}
+		}
+		return items;
+	}
+
+	inline static std::string& GetText(Context& ctx)
+	{
+		if (ctx.m_segments.empty() ||
+			ctx.m_segments.back().m_kind != Segment::Kind::Text)
+		{
+			ctx.m_segments.emplace_back(Segment::Kind::Text);
+		}
+		return ctx.m_segments.back().m_text;
+	}
+
+	/**
+	 * @brief Decide how the given subtree is written:
+	 *        - large containers are split into chunks of items
+	 *        - other containers are walked by the planner; each of their
+	 *          children is planned again if there are only a few of them,
+	 *          or becomes a job on its own otherwise
+	 *        - anything else is written by the planner directly
+	 *
+	 */
+	inline static void Plan(Context& ctx, const ObjType& obj, size_t nestLevel)
+	{
+		if (!IsSplittable(obj))
+		{
+			WriteValue(std::back_inserter(GetText(ctx)),
+				ctx.m_config, ctx.m_newLineCache, nestLevel, obj);
+			return;
+		}
+
+		const bool isList =
+			(obj.GetCategory() == Internal::Obj::ObjCategory::List);
+		ctx.m_itemLists.push_back(GetItems(obj));
+		const std::vector<Item>& items = ctx.m_itemLists.back();
+		const size_t size = items.size();
+
+		GetText(ctx).push_back(isList ? '[' : '{');
+
+		if (size >= 2 * ctx.m_minChunkSize)
+		{
+			const size_t numChunks = std::min(
+				size / ctx.m_minChunkSize, ctx.m_numThreads * 4);
+			for (size_t i = 0; i < numChunks; ++i)
+			{
+				ctx.m_segments.emplace_back(Segment::Kind::Items);
+				Segment& seg = ctx.m_segments.back();
+				seg.m_items = &items;
+				seg.m_begin = (size * i) / numChunks;
+				seg.m_end = (size * (i + 1)) / numChunks;
+				seg.m_nestLevel = nestLevel + 1;
+			}
+		}
+		else
+		{
+			const bool isFew = (size < ctx.m_numThreads);
+			for (size_t i = 0; i < size; ++i)
+			{
+				WriteItemPrefix(std::back_inserter(GetText(ctx)),
+					ctx.m_config, ctx.m_newLineCache, nestLevel + 1,
+					i, items[i].m_key);
+
+				const ObjType& val = *(items[i].m_val);
+				if (isFew || !IsSplittable(val))
+				{
+					Plan(ctx, val, nestLevel + 1);
+				}
+				else
+				{
+					ctx.m_segments.emplace_back(Segment::Kind::Whole);
+					Segment& seg = ctx.m_segments.back();
+					seg.m_obj = &val;
+					seg.m_nestLevel = nestLevel + 1;
+				}
+			}
+		}
+
+		std::string& text = GetText(ctx);
+		if (_Policy::IsPretty(ctx.m_config) && size > 0)
+		{
+			WriteNewLine(std::back_inserter(text),
+				ctx.m_config, ctx.m_newLineCache, nestLevel);
+		}
+		text.push_back(isList ? ']' : '}');
+	}
+
+	inline static void RunJob(const WriterConfig& config, Segment& seg)
+	{
+		std::string newLineCache;
+		auto destIt = std::back_inserter(seg.m_text);
+		try
+		{
+			if (seg.m_kind == Segment::Kind::Whole)
+			{
+				WriteValue(destIt, config, newLineCache,
+					seg.m_nestLevel, *(seg.m_obj));
+				return;
+			}
+
+			const std::vector<Item>& items = *(seg.m_items);
+			for (size_t i = seg.m_begin; i < seg.m_end; ++i)
+			{
+				WriteItemPrefix(destIt, config, newLineCache,
+					seg.m_nestLevel, i, items[i].m_key);
+				WriteValue(destIt, config, newLineCache,
+					seg.m_nestLevel, *(items[i].m_val));
+			}
+		}
+		catch (...)
+		{
+			seg.m_error = std::current_exception();
+		}
+	}
+
+	inline static void JoinThreads(std::vector<std::thread>& threads)
+	{
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	/**
+	 * @param numThreads   The number of threads to use, including the calling
+	 *                     thread; 0 means the number of hardware threads
+	 * @param minChunkSize The minimum number of items in a chunk
+	 */
+	template<typename _OutputIt>
+	inline static void Write(_OutputIt destIt,
+		const ObjType& obj,
+		const WriterConfig& config,
+		const WriterStates& state,
+		size_t numThreads,
+		size_t minChunkSize = sk_defaultMinChunkSize)
+	{
+		if (numThreads == 0)
+		{
+			numThreads = std::max<unsigned int>(
+				std::thread::hardware_concurrency(), 1);
+		}
+		if (numThreads == 1)
+		{
+			_ObjWriter::Write(destIt, obj, config, state);
+			return;
+		}
+
+		Context ctx(config, numThreads, minChunkSize);
+		Plan(ctx, obj, state.m_nestLevel);
+
+		std::vector<Segment*> jobs;
+		for (Segment& seg : ctx.m_segments)
+		{
+			if (seg.m_kind != Segment::Kind::Text)
+			{
+				jobs.push_back(&seg);
+			}
+		}
+
+		// workers only read the config and the object tree, so they are
+		// shared by all threads
+		std::atomic<size_t> nextJob(0);
+		auto worker = [&jobs, &nextJob, &config]()
+		{
+			for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+			{
+				RunJob(config, *(jobs[i]));
+			}
+		};
+
+		std::vector<std::thread> threads;
+		const size_t numWorkers = std::min(numThreads, jobs.size());
+		if (numWorkers > 1)
+		{
+			threads.reserve(numWorkers - 1);
+		}
+		try
+		{
+			try
+			{
+				for (size_t i = 1; i < numWorkers; ++i)
+				{
+					threads.emplace_back(worker);
+				}
+			}
+			catch (const std::system_error&)
+			{
+				// fewer threads are available; the rest of jobs are still
+				// picked up by the running ones
+			}
+			worker();
+		}
+		catch (...)
+		{
+			// the running threads must be joined before they are destroyed
+			JoinThreads(threads);
+			throw;
+		}
+		JoinThreads(threads);
+
+		for (const Segment* job : jobs)
+		{
+			if (job->m_error)
+			{
+				std::rethrow_exception(job->m_error);
+			}
+		}
+		for (const Segment& seg : ctx.m_segments)
+		{
+			Internal::WriteChars(destIt, seg.m_text.data(), seg.m_text.size());
+		}
+	}
+
+	template<typename _OutputIt>
+	inline static void Write(_OutputIt destIt,
+		const ObjType& obj,
+		const WriterConfig& config,
+		const WriterStates& state)
+	{
+		Write(destIt, obj, config, state, 0);
+	}
+
+}; // struct JsonWriterParallelImpl
+
+} // namespace SimpleJson
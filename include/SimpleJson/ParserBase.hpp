@@ -38,6 +38,9 @@ public: // static members:
 	using RetType       = _RetType;
 	using IteratorType  = Internal::Obj::FrIterator<InputChType, true>;
 	using ISMType       = ForwardIteratorStateMachine<IteratorType>;
+	// The container is stored contiguously, so we can use raw pointers
+	// to avoid the type-erased iterator, and to enable block processing
+	using CtnISMType    = ForwardIteratorStateMachine<const InputChType*>;
 
 public:
 
@@ -51,18 +54,14 @@ public:
 
 	virtual RetType Parse(const ContainerType& ctn) const
 	{
-		ISMType ism(
-			Internal::Obj::ToFrIt<true>(ctn.cbegin()),
-			Internal::Obj::ToFrIt<true>(ctn.cend()));
+		CtnISMType ism(ctn.data(), ctn.data() + ctn.size());
 
 		return Parse(ism);
 	}
 
 	virtual RetType ParseTillEnd(const ContainerType& ctn) const
 	{
-		ISMType ism(
-			Internal::Obj::ToFrIt<true>(ctn.cbegin()),
-			Internal::Obj::ToFrIt<true>(ctn.cend()));
+		CtnISMType ism(ctn.data(), ctn.data() + ctn.size());
 
 		auto res = Parse(ism);
 
@@ -77,6 +76,44 @@ public:
 		return res;
 	}
 
+	/**
+	 * @brief Parse into an existing object, so parsers supporting it can
+	 *        reuse the memory held by the object (e.g., the capacity of a
+	 *        string or a list) when inputs of the same shape are parsed
+	 *        again and again; by default, the object is simply replaced.
+	 *        NOTE: the object is left in an unspecified (but valid) state
+	 *        if an exception is thrown
+	 *
+	 */
+	virtual void ParseInto(
+		InputStateMachineIf<InputChType>& ism, RetType& target) const
+	{
+		target = Parse(ism);
+	}
+
+	virtual void ParseInto(const ContainerType& ctn, RetType& target) const
+	{
+		CtnISMType ism(ctn.data(), ctn.data() + ctn.size());
+
+		ParseInto(ism, target);
+	}
+
+	virtual void ParseTillEndInto(
+		const ContainerType& ctn, RetType& target) const
+	{
+		CtnISMType ism(ctn.data(), ctn.data() + ctn.size());
+
+		ParseInto(ism, target);
+
+		ism.SkipWhiteSpace();
+
+		if (!ism.IsEnd())
+		{
+			throw ParseError("Extra Data",
+				ism.GetLineCount(), ism.GetColCount());
+		}
+	}
+
 }; // class ParserBase
 
 } // namespace SimpleJson
@@ -0,0 +1,72 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <utility>
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A fragment of JSON text that is already serialized (e.g., a cached
+ *        payload), which is written verbatim by the writer, so it doesn't
+ *        need to be parsed into an object tree and serialized again.
+ *        The content is *not* validated here; use `LoadRawJson` to validate
+ *        it once, when the fragment is created
+ *
+ * @tparam _ContainerType The type of container used to store the JSON text
+ */
+template<typename _ContainerType>
+class RawJsonImpl
+{
+public: // static members:
+
+	using ContainerType = _ContainerType;
+
+public:
+
+	RawJsonImpl() :
+		RawJsonImpl(ContainerType({ 'n', 'u', 'l', 'l' }))
+	{}
+
+	/**
+	 * @brief Construct a new Raw Json object
+	 *
+	 * @param json A single JSON value (e.g., `{"a":1}`); it's the caller's
+	 *             responsibility to make sure it's valid
+	 */
+	explicit RawJsonImpl(ContainerType json) :
+		m_json(std::move(json))
+	{}
+
+	~RawJsonImpl() = default;
+
+	const ContainerType& GetJson() const
+	{
+		return m_json;
+	}
+
+	bool operator==(const RawJsonImpl& other) const
+	{
+		return m_json == other.m_json;
+	}
+
+	bool operator!=(const RawJsonImpl& other) const
+	{
+		return !(*this == other);
+	}
+
+private:
+
+	ContainerType m_json;
+
+}; // class RawJsonImpl
+
+} // namespace SimpleJson
@@ -0,0 +1,37 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "OutputSink.hpp"
+#include "WriterConfig.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+template<typename _RawJsonType>
+struct JsonWriterRawJsonImpl
+{
+	/**
+	 * @brief Write the JSON text as it is, with a single block copy;
+	 *        NOTE: it's not re-indented in the pretty mode
+	 *
+	 */
+	template<typename _OutputIt>
+	inline static void Write(_OutputIt it,
+		const _RawJsonType& obj,
+		const WriterConfig&,
+		const WriterStates&)
+	{
+		const auto& json = obj.GetJson();
+		Internal::WriteChars(it, json.data(), json.size());
+	}
+}; // struct JsonWriterRawJsonImpl
+
+} // namespace SimpleJson
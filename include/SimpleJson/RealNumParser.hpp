@@ -5,6 +5,14 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstdlib>
+
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "Decimal.hpp"
 #include "ParserBase.hpp"
 
 #ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
@@ -88,6 +96,103 @@ inline bool ParseNorPSign(InputStateMachineIf<_InputChType>& ism)
 	}
 }
 
+/**
+ * @brief Load eight characters into a 64-bit integer, where the first
+ *        character is placed in the lowest byte (i.e., little-endian order,
+ *        regardless of the platform's endianness)
+ *
+ */
+template<typename _InputChType>
+inline uint64_t LoadEightChars(const _InputChType* ptr)
+{
+	uint64_t val = 0;
+	for (size_t i = 0; i < 8; ++i)
+	{
+		val |= static_cast<uint64_t>(static_cast<uint8_t>(ptr[i])) << (i * 8);
+	}
+	return val;
+}
+
+/**
+ * @brief Check if all eight characters loaded by `LoadEightChars` are
+ *        digit characters ['0'-'9'], using SWAR (SIMD within a register)
+ *        - The high nibble of each byte must be 0x3, and
+ *        - The high nibble of each byte plus 6 must still be 0x3
+ *          (i.e., the byte is not greater than 0x39)
+ *
+ */
+inline bool IsEightDigits(uint64_t val)
+{
+	return (
+		(val & 0xF0F0F0F0F0F0F0F0ULL) |
+		(((val + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)
+	) == 0x3333333333333333ULL;
+}
+
+/**
+ * @brief Convert eight digit characters loaded by `LoadEightChars` to its
+ *        integer value, using SWAR (SIMD within a register)
+ *        NOTE: the caller must ensure all of them are digits, by calling
+ *        `IsEightDigits`
+ *
+ */
+inline uint32_t EightDigitsToUInt(uint64_t val)
+{
+	constexpr uint64_t mask = 0x000000FF000000FFULL;
+	constexpr uint64_t mul1 = 100ULL   + (1000000ULL << 32);
+	constexpr uint64_t mul2 = 1ULL     + (10000ULL   << 32);
+
+	val -= 0x3030303030303030ULL;
+	// each 16-bit lane holds a 2-digit value
+	val = (val * 10) + (val >> 8);
+	// combine the four 2-digit values
+	val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+
+	return static_cast<uint32_t>(val);
+}
+
+/**
+ * @brief Consume digit characters eight at a time, if the input is stored
+ *        contiguously; otherwise, nothing will be consumed
+ *
+ * @return a pair of the number of digits consumed, and the advanced output
+ *         iterator
+ */
+template<typename _InputChType, typename OutputIt>
+inline std::pair<size_t, OutputIt> ParseEightDigitsBlocks(
+	InputStateMachineIf<_InputChType>& ism, OutputIt dest, std::true_type)
+{
+	size_t len = 0;
+
+	const _InputChType* begin = nullptr;
+	const _InputChType* end = nullptr;
+	std::tie(begin, end) = ism.GetBlock();
+
+	while ((begin != nullptr) &&
+		(end - begin) >= 8 &&
+		IsEightDigits(LoadEightChars(begin)))
+	{
+		dest = std::copy(begin, begin + 8, dest);
+		ism.AdvanceInLine(8);
+		begin += 8;
+		len += 8;
+	}
+
+	return std::make_pair(len, dest);
+}
+
+/**
+ * @brief Characters wider than one byte can't be checked by the SWAR
+ *        method, so nothing will be consumed
+ *
+ */
+template<typename _InputChType, typename OutputIt>
+inline std::pair<size_t, OutputIt> ParseEightDigitsBlocks(
+	InputStateMachineIf<_InputChType>&, OutputIt dest, std::false_type)
+{
+	return std::make_pair(0, dest);
+}
+
 /**
  * @brief Parse a series of digit characters ['0'-'9'], and put them into the
  *        output iterator
@@ -99,6 +204,10 @@ inline void ParseNumDigits(
 {
 	size_t len = 0;
 
+	// Fast path - eight digits at a time
+	std::tie(len, dest) = ParseEightDigitsBlocks(ism, dest,
+		std::integral_constant<bool, sizeof(_InputChType) == 1>());
+
 	while(true)
 	{
 		if (ism.IsEnd())
@@ -206,8 +315,15 @@ inline void ParseFrac(InputStateMachineIf<_InputChType>& ism, OutputIt dest)
 /**
  * @brief Parse the exponential part, which is 'e [ minus / plus ] 1*DIGIT'
  *
+ * @tparam _IsVerbatim Whether to output the characters as they are (e.g.,
+ *                     `E+5`), so the text of a number can be written back
+ *                     byte for byte; otherwise, it's normalized to `e5`
  */
-template<bool _Optional, typename _InputChType, typename OutputIt>
+template<
+	bool _Optional,
+	bool _IsVerbatim = false,
+	typename _InputChType,
+	typename OutputIt>
 inline void ParseExp(InputStateMachineIf<_InputChType>& ism, OutputIt dest)
 {
 	if (ism.IsEnd() && _Optional)
@@ -219,11 +335,17 @@ inline void ParseExp(InputStateMachineIf<_InputChType>& ism, OutputIt dest)
 	if (ch == 'e' || ch == 'E')
 	{
 		ism.GetCharAndAdv();
-		*dest++ = 'e';
+		*dest++ = _IsVerbatim ? ch : 'e';
+
+		auto signCh = ism.IsEnd() ? ch : ism.GetChar();
 		if (!ParseNorPSign<true>(ism))
 		{
 			*dest++ = '-';
 		}
+		else if (_IsVerbatim && signCh == '+')
+		{
+			*dest++ = '+';
+		}
 		return ParseNumDigits(ism, dest);
 	}
 	else if (!_Optional)
@@ -262,6 +384,255 @@ inline std::pair<_ContainerType, _ContainerType> ParseNum(
 	return std::make_pair(iRes, fRes);
 }
 
+/**
+ * @brief Accumulate a series of digit characters ['0'-'9'] into the
+ *        coefficient of a decimal number
+ *
+ * @exception ParseError thrown if there is no digit, or the coefficient
+ *                       overflows
+ *
+ * @return the number of digits consumed
+ */
+template<typename _CoefType, typename _InputChType>
+inline size_t ParseDecDigits(
+	InputStateMachineIf<_InputChType>& ism, _CoefType& coef)
+{
+	constexpr _CoefType maxCoef = static_cast<_CoefType>(~_CoefType(0));
+	constexpr _CoefType maxCoefForBlock =
+		(maxCoef - _CoefType(99999999)) / _CoefType(100000000);
+
+	size_t len = 0;
+
+	// Fast path - eight digits at a time
+	const _InputChType* begin = nullptr;
+	const _InputChType* end = nullptr;
+	std::tie(begin, end) = ism.GetBlock();
+
+	while ((sizeof(_InputChType) == 1) &&
+		(begin != nullptr) &&
+		(end - begin) >= 8 &&
+		(coef <= maxCoefForBlock) &&
+		IsEightDigits(LoadEightChars(begin)))
+	{
+		coef = (coef * _CoefType(100000000)) +
+			_CoefType(EightDigitsToUInt(LoadEightChars(begin)));
+		ism.AdvanceInLine(8);
+		begin += 8;
+		len += 8;
+	}
+
+	while (!ism.IsEnd())
+	{
+		auto ch = ism.GetChar();
+		if (ch < '0' || '9' < ch)
+		{
+			break;
+		}
+
+		_CoefType digit = static_cast<_CoefType>(ch - '0');
+		if (coef > ((maxCoef - digit) / 10))
+		{
+			throw ParseError("The decimal value is out of range",
+				ism.GetLineCount(), ism.GetColCount());
+		}
+		coef = (coef * 10) + digit;
+
+		ism.GetCharAndAdv();
+		++len;
+	}
+
+	if (len == 0)
+	{
+		throw ParseError(
+			ism.IsEnd() ? "Unexpected Ends" : "Expecting a numeric value",
+			ism.GetLineCount(), ism.GetColCount());
+	}
+
+	return len;
+}
+
+/**
+ * @brief Parse number, which is '[ minus ] int [ frac ] [ exp ]', into an
+ *        exact decimal representation, `(-1)^sign * coef * 10^exp`;
+ *        the digits are accumulated directly, without any intermediate text
+ *        or floating point
+ *
+ * @param notation the notation of the number in the text
+ */
+template<typename _CoefType, typename _InputChType>
+inline void ParseDecimal(
+	InputStateMachineIf<_InputChType>& ism,
+	bool& isNeg,
+	_CoefType& coef,
+	int32_t& exp,
+	DecimalNotation& notation)
+{
+	// Large enough for any real use case, while it won't overflow int32_t
+	constexpr uint32_t maxExpVal = 99999999;
+
+	isNeg = !ParseNSign<true>(ism);
+	coef = _CoefType(0);
+	exp = 0;
+	notation = DecimalNotation(DecimalNotation::Form::Plain, 0, 'e', '\0', 0);
+
+	// int
+	switch (ism.GetChar())
+	{
+	case '0': // the number is a single '0'
+		ism.GetCharAndAdv();
+		break;
+
+	case '1':
+	case '2':
+	case '3':
+	case '4':
+	case '5':
+	case '6':
+	case '7':
+	case '8':
+	case '9': // the number doesn't start with 0
+		ParseDecDigits(ism, coef);
+		break;
+
+	default:
+		throw ParseError("Expecting a numeric value",
+			ism.GetLineCount(), ism.GetColCount());
+	}
+
+	// [ frac ]
+	if (!ism.IsEnd() && ism.GetChar() == '.')
+	{
+		ism.GetCharAndAdv();
+		exp -= static_cast<int32_t>(ParseDecDigits(ism, coef));
+	}
+
+	// [ exp ]
+	if (!ism.IsEnd() && (ism.GetChar() == 'e' || ism.GetChar() == 'E'))
+	{
+		notation.m_form = DecimalNotation::Form::Exp;
+		notation.m_expCh = static_cast<char>(ism.GetCharAndAdv());
+		if (!ism.IsEnd() && (ism.GetChar() == '-' || ism.GetChar() == '+'))
+		{
+			notation.m_expSign = static_cast<char>(ism.GetChar());
+		}
+		bool isExpPos = ParseNorPSign<true>(ism);
+
+		uint32_t expVal = 0;
+		size_t len = 0;
+		while (!ism.IsEnd() && ('0' <= ism.GetChar() && ism.GetChar() <= '9'))
+		{
+			expVal = (expVal * 10) +
+				static_cast<uint32_t>(ism.GetCharAndAdv() - '0');
+			if (expVal > maxExpVal)
+			{
+				throw ParseError("The decimal exponent is out of range",
+					ism.GetLineCount(), ism.GetColCount());
+			}
+			++len;
+		}
+		if (len == 0)
+		{
+			throw ParseError(
+				ism.IsEnd() ? "Unexpected Ends" : "Expecting a numeric value",
+				ism.GetLineCount(), ism.GetColCount());
+		}
+
+		notation.m_exp = (isExpPos ?
+			static_cast<int32_t>(expVal) :
+			-static_cast<int32_t>(expVal));
+		notation.m_numExpDigits = static_cast<uint32_t>(len);
+		exp += notation.m_exp;
+	}
+}
+
+/**
+ * @brief Parse number, which is '[ minus ] int [ frac ] [ exp ]', and append
+ *        the whole number to the given container; this allows the caller to
+ *        reuse the container (and its capacity) for multiple numbers
+ *
+ * @tparam _IsVerbatim Whether to keep the text of the exp part as it is
+ *                     (see `ParseExp`)
+ *
+ * @return true if the number parsed is an integer (i.e., there is no frac
+ *         part and exp part), otherwise, false
+ *
+ */
+template<
+	bool _IsVerbatim = false,
+	typename _ContainerType,
+	typename _InputChType = typename _ContainerType::value_type>
+inline bool ParseNumInto(
+	InputStateMachineIf<_InputChType>& ism, _ContainerType& dest)
+{
+	if (!ParseNSign<true>(ism))
+	{
+		dest.push_back('-');
+	}
+
+	ParseInt(ism, std::back_inserter(dest));
+
+	size_t iSize = dest.size();
+
+	ParseFrac<true>(ism, std::back_inserter(dest));
+
+	ParseExp<true, _IsVerbatim>(ism, std::back_inserter(dest));
+
+	return iSize == dest.size();
+}
+
+/**
+ * @brief Convert the integer part returned by `ParseNum` (i.e.,
+ *        "[ minus ] int") to a 64-bit signed integer, and the digits are
+ *        accumulated eight at a time.
+ *        Values that are out of the range of 64-bit signed integer will fall
+ *        back to `atoll`, so the behavior is the same as before
+ *
+ */
+template<typename _ContainerType>
+inline long long IntStrToInt64(const _ContainerType& iStr)
+{
+	// Max number of digits that won't overflow uint64_t
+	constexpr size_t maxDigits = std::numeric_limits<uint64_t>::digits10;
+	constexpr uint64_t posMax = static_cast<uint64_t>(
+		std::numeric_limits<long long>::max());
+
+	auto begin = iStr.data();
+	auto end = iStr.data() + iStr.size();
+
+	bool isNeg = (begin != end) && (*begin == '-');
+	begin += (isNeg ? 1 : 0);
+
+	if (static_cast<size_t>(end - begin) > maxDigits)
+	{
+		return atoll(iStr.c_str());
+	}
+
+	uint64_t val = 0;
+	for (; (end - begin) >= 8; begin += 8)
+	{
+		val = (val * 100000000ULL) +
+			EightDigitsToUInt(LoadEightChars(begin));
+	}
+	for (; begin != end; ++begin)
+	{
+		val = (val * 10) + static_cast<uint64_t>(*begin - '0');
+	}
+
+	if (isNeg)
+	{
+		return (val <= (posMax + 1)) ?
+			// -(val - 1) - 1 to avoid overflow when val == (posMax + 1)
+			(val == 0 ? 0 : (-static_cast<long long>(val - 1) - 1)) :
+			atoll(iStr.c_str());
+	}
+	else
+	{
+		return (val <= posMax) ?
+			static_cast<long long>(val) :
+			atoll(iStr.c_str());
+	}
+}
+
 } // namespace Internal
 
 
@@ -327,8 +698,7 @@ public:
 		else
 		{
 			// It's a interger number
-			ContainerType fullRes = iRes + fRes;
-			long long val = atoll(fullRes.c_str());
+			long long val = Internal::IntStrToInt64(iRes);
 			return IntType(val);
 		}
 	}
@@ -392,8 +762,7 @@ public:
 		else
 		{
 			// It's a interger number
-			ContainerType fullRes = iRes + fRes;
-			long long val = atoll(fullRes.c_str());
+			long long val = Internal::IntStrToInt64(iRes);
 			return ObjType(val);
 		}
 	}
@@ -465,4 +834,194 @@ public:
 
 }; // class GenericNumberParserImpl
 
+
+/**
+ * @brief Parser for numbers, which only validates the input, and keeps the
+ *        text of the number exactly as it is (e.g., `1E+5` stays `1E+5`);
+ *        the conversion to the numeric value is deferred to the first access
+ *        of the value (e.g., `LazyNumberImpl`)
+ *
+ * @tparam _ContainerType Type of containers which *may* be needed during
+ *                        intermediate steps.
+ *                        Meanwhile, the input character type is inferred by
+ *                        `_ContainerType::value_type`
+ * @tparam _ObjType       The type used to construct the number, which is
+ *                        constructed by `_ObjType(text, isInteger)`
+ * @tparam _RetType       The type that will be returned by the parser
+ */
+template<
+	typename _ContainerType,
+	typename _ObjType,
+	typename _RetType = _ObjType>
+class LazyNumberParserImpl : public ParserBase<_ContainerType, _RetType>
+{
+public: // static members:
+
+	using Base = ParserBase<_ContainerType, _RetType>;
+	using Self = LazyNumberParserImpl<_ContainerType, _ObjType, _RetType>;
+
+	using ContainerType = _ContainerType;
+	using InputChType   = typename ContainerType::value_type;
+	using ObjType       = _ObjType;
+	using RetType       = _RetType;
+	using IteratorType  = Internal::Obj::FrIterator<InputChType, true>;
+	using ISMType       = ForwardIteratorStateMachine<IteratorType>;
+
+public:
+
+	LazyNumberParserImpl() = default;
+
+	// LCOV_EXCL_START
+	virtual ~LazyNumberParserImpl() = default;
+	// LCOV_EXCL_STOP
+
+	using Base::Parse;
+
+	virtual RetType Parse(InputStateMachineIf<InputChType>& ism) const override
+	{
+		ContainerType raw;
+
+		ism.SkipWhiteSpace();
+
+		// the text is kept as it is, so it can be written back byte for byte
+		bool isInt = Internal::ParseNumInto<true>(ism, raw);
+
+		return ObjType(std::move(raw), isInt);
+	}
+
+}; // class LazyNumberParserImpl
+
+
+/**
+ * @brief Parser for general numeric objects, which keeps the text of the
+ *        number exactly as it is, besides the value; it can be used in place
+ *        of `GenericNumberParserImpl` (e.g., by `GenericObjectParserImpl`),
+ *        so generic objects are able to hold lazy numbers
+ *        (e.g., `LazyNumberNodeImpl`)
+ *
+ * @tparam _ContainerType Type of containers which *may* be needed during
+ *                        intermediate steps.
+ *                        Meanwhile, the input character type is inferred by
+ *                        `_ContainerType::value_type`
+ * @tparam _IntType       The type used to construct the integer type, which
+ *                        is constructed by `_IntType(text, value)`
+ * @tparam _RealType      The type used to construct the real type, which
+ *                        is constructed by `_RealType(text, value)`
+ * @tparam _RetType       The type that will be returned by the parser
+ */
+template<
+	typename _ContainerType,
+	typename _IntType,
+	typename _RealType,
+	typename _RetType>
+class LazyGenericNumberParserImpl : public ParserBase<_ContainerType, _RetType>
+{
+public: // static members:
+
+	using Base = ParserBase<_ContainerType, _RetType>;
+	using Self = LazyGenericNumberParserImpl<
+		_ContainerType, _IntType, _RealType, _RetType>;
+
+	using ContainerType = _ContainerType;
+	using InputChType   = typename ContainerType::value_type;
+	using IntType       = _IntType;
+	using RealType      = _RealType;
+	using RetType       = _RetType;
+	using IteratorType  = Internal::Obj::FrIterator<InputChType, true>;
+	using ISMType       = ForwardIteratorStateMachine<IteratorType>;
+
+public:
+
+	LazyGenericNumberParserImpl() = default;
+
+	// LCOV_EXCL_START
+	virtual ~LazyGenericNumberParserImpl() = default;
+	// LCOV_EXCL_STOP
+
+	using Base::Parse;
+
+	virtual RetType Parse(InputStateMachineIf<InputChType>& ism) const override
+	{
+		ContainerType raw;
+
+		ism.SkipWhiteSpace();
+
+		bool isInt = Internal::ParseNumInto<true>(ism, raw);
+
+		if (isInt)
+		{
+			long long val = Internal::IntStrToInt64(raw);
+			return IntType(std::move(raw), val);
+		}
+		else
+		{
+			double val = atof(raw.c_str());
+			return RealType(std::move(raw), val);
+		}
+	}
+
+}; // class LazyGenericNumberParserImpl
+
+
+/**
+ * @brief Parser for numbers that need to be kept exactly as they are
+ *        in decimal (e.g., prices); the number is parsed into a coefficient
+ *        and a base-10 exponent (e.g., `DecimalImpl`)
+ *
+ * @tparam _ContainerType Type of containers which *may* be needed during
+ *                        intermediate steps.
+ *                        Meanwhile, the input character type is inferred by
+ *                        `_ContainerType::value_type`
+ * @tparam _ObjType       The type used to construct the number, which is
+ *                        constructed by
+ *                        `_ObjType(isNeg, coef, exp, notation)`, and the
+ *                        type of coefficient is given by
+ *                        `_ObjType::CoefType`
+ * @tparam _RetType       The type that will be returned by the parser
+ */
+template<
+	typename _ContainerType,
+	typename _ObjType,
+	typename _RetType = _ObjType>
+class DecimalParserImpl : public ParserBase<_ContainerType, _RetType>
+{
+public: // static members:
+
+	using Base = ParserBase<_ContainerType, _RetType>;
+	using Self = DecimalParserImpl<_ContainerType, _ObjType, _RetType>;
+
+	using ContainerType = _ContainerType;
+	using InputChType   = typename ContainerType::value_type;
+	using ObjType       = _ObjType;
+	using RetType       = _RetType;
+	using CoefType      = typename ObjType::CoefType;
+	using IteratorType  = Internal::Obj::FrIterator<InputChType, true>;
+	using ISMType       = ForwardIteratorStateMachine<IteratorType>;
+
+public:
+
+	DecimalParserImpl() = default;
+
+	// LCOV_EXCL_START
+	virtual ~DecimalParserImpl() = default;
+	// LCOV_EXCL_STOP
+
+	using Base::Parse;
+
+	virtual RetType Parse(InputStateMachineIf<InputChType>& ism) const override
+	{
+		bool isNeg = false;
+		CoefType coef = CoefType(0);
+		int32_t exp = 0;
+		DecimalNotation notation;
+
+		ism.SkipWhiteSpace();
+
+		Internal::ParseDecimal(ism, isNeg, coef, exp, notation);
+
+		return ObjType(isNeg, coef, exp, notation);
+	}
+
+}; // class DecimalParserImpl
+
 } // namespace SimpleJson
@@ -5,6 +5,16 @@
 
 #pragma once
 
+#include <cmath>
+#include <cstdint>
+
+#include <limits>
+#include <type_traits>
+
+#include "Decimal.hpp"
+#include "LazyNumber.hpp"
+#include "NumFormatter.hpp"
+#include "Utils.hpp"
 #include "WriterConfig.hpp"
 #include "Internal/SimpleObjects.hpp"
 
@@ -26,18 +36,11 @@ struct JsonWriterRealNumImpl
 	{
 		if(obj.IsTrue())
 		{
-			*it++ = 't';
-			*it++ = 'r';
-			*it++ = 'u';
-			*it++ = 'e';
+			Internal::WriteChars(it, "true", 4);
 		}
 		else
 		{
-			*it++ = 'f';
-			*it++ = 'a';
-			*it++ = 'l';
-			*it++ = 's';
-			*it++ = 'e';
+			Internal::WriteChars(it, "false", 5);
 		}
 	}
 
@@ -48,7 +51,74 @@ struct JsonWriterRealNumImpl
 		const WriterStates&)
 	{
 		auto str = obj.ToString();
-		std::copy(str.begin(), str.end(), it);
+		Internal::WriteChars(it, str.data(), str.size());
+	}
+
+	template<typename _OutputIt>
+	inline static void WriteInt(_OutputIt it, int64_t val)
+	{
+		char buf[Internal::sk_intFormatBufSize];
+		const char* end = Internal::FormatInt(buf, val);
+		Internal::WriteChars(it, buf, static_cast<size_t>(end - buf));
+	}
+
+	template<typename _OutputIt>
+	inline static void WriteUInt(_OutputIt it, uint64_t val)
+	{
+		char buf[Internal::sk_intFormatBufSize];
+		const char* end = Internal::FormatUInt(buf, val);
+		Internal::WriteChars(it, buf, static_cast<size_t>(end - buf));
+	}
+
+	/**
+	 * @brief Write the raw text of the number, if it's a lazy number node
+	 *        (see `LazyNumberNodeImpl`)
+	 *
+	 * @return whether the raw text is written
+	 */
+	template<typename _OutputIt>
+	inline static bool WriteRaw(_OutputIt it,
+		const Internal::Obj::RealNumBaseObject<_ToStringType>& obj)
+	{
+		auto lazyNum =
+			dynamic_cast<const LazyNumberNodeBase<_ToStringType>*>(&obj);
+		if (lazyNum == nullptr)
+		{
+			return false;
+		}
+
+		const auto& raw = lazyNum->GetRaw();
+		Internal::WriteChars(it, raw.data(), raw.size());
+		return true;
+	}
+
+	/**
+	 * @brief Write the shortest representation that round-trips, without
+	 *        going through `ToString`; NaN and infinity, which can't be
+	 *        represented in JSON, are left to `ToString`.
+	 *        Lazy numbers are written as their raw text instead
+	 *
+	 */
+	template<typename _FloatType, typename _OutputIt>
+	inline static void WriteReal(_OutputIt it,
+		const Internal::Obj::RealNumBaseObject<_ToStringType>& obj,
+		const WriterConfig& config,
+		const WriterStates& state)
+	{
+		if (WriteRaw(it, obj))
+		{
+			return;
+		}
+
+		const _FloatType val = static_cast<_FloatType>(obj.AsCppDouble());
+		if (!std::isfinite(val))
+		{
+			return WriteNumber(it, obj, config, state);
+		}
+
+		char buf[Internal::sk_realFormatBufSize];
+		const char* end = Internal::FormatReal(buf, val);
+		Internal::WriteChars(it, buf, static_cast<size_t>(end - buf));
 	}
 
 	template<typename _OutputIt>
@@ -62,10 +132,319 @@ struct JsonWriterRealNumImpl
 		case Internal::Obj::RealNumType::Bool:
 			return WriteBool(it, obj, config, state);
 
+		case Internal::Obj::RealNumType::Int8:
+		case Internal::Obj::RealNumType::Int16:
+		case Internal::Obj::RealNumType::Int32:
+		case Internal::Obj::RealNumType::Int64:
+		{
+			// The text of a lazy integer only differs from its value when
+			// it's `-0`, or out of range (i.e., saturated), so the raw text
+			// is only looked for in these cases
+			const int64_t val = obj.AsCppInt64();
+			if ((val == 0 ||
+					val == (std::numeric_limits<int64_t>::max)() ||
+					val == (std::numeric_limits<int64_t>::min)()) &&
+				WriteRaw(it, obj))
+			{
+				return;
+			}
+			return WriteInt(it, val);
+		}
+
+		case Internal::Obj::RealNumType::UInt8:
+		case Internal::Obj::RealNumType::UInt16:
+		case Internal::Obj::RealNumType::UInt32:
+		case Internal::Obj::RealNumType::UInt64:
+		{
+			const uint64_t val = obj.AsCppUInt64();
+			if ((val == 0 ||
+					val == (std::numeric_limits<uint64_t>::max)()) &&
+				WriteRaw(it, obj))
+			{
+				return;
+			}
+			return WriteUInt(it, val);
+		}
+
+		case Internal::Obj::RealNumType::Float:
+			return WriteReal<float>(it, obj, config, state);
+
+		case Internal::Obj::RealNumType::Double:
+			return WriteReal<double>(it, obj, config, state);
+
 		default:
 			return WriteNumber(it, obj, config, state);
 		}
 	}
 }; // struct JsonWriterRealNumImpl
 
+/**
+ * @brief Writer for number objects whose C++ value type is known at compile
+ *        time (e.g., `Int64`), so the value is formatted directly, without
+ *        checking its type at runtime; the output is identical to the one
+ *        produced by `JsonWriterRealNumImpl`
+ *
+ * @tparam _NumObjType The type of the number object, which provides `GetVal`
+ */
+template<typename _NumObjType>
+struct JsonWriterNumValImpl
+{
+	template<typename _OutputIt>
+	inline static void Write(_OutputIt it,
+		const _NumObjType& obj,
+		const WriterConfig&,
+		const WriterStates&)
+	{
+		WriteVal(it, obj, obj.GetVal());
+	}
+
+private:
+
+	template<typename _OutputIt>
+	inline static void WriteVal(_OutputIt it, const _NumObjType&, bool val)
+	{
+		if (val)
+		{
+			Internal::WriteChars(it, "true", 4);
+		}
+		else
+		{
+			Internal::WriteChars(it, "false", 5);
+		}
+	}
+
+	template<typename _OutputIt, typename _IntType>
+	inline static
+	typename std::enable_if<
+		std::is_integral<_IntType>::value &&
+			!std::is_same<_IntType, bool>::value
+	>::type
+	WriteVal(_OutputIt it, const _NumObjType&, _IntType val)
+	{
+		char buf[Internal::sk_intFormatBufSize];
+		const char* end = FormatInteger(buf, val,
+			std::is_signed<_IntType>());
+		Internal::WriteChars(it, buf, static_cast<size_t>(end - buf));
+	}
+
+	/**
+	 * @brief NaN and infinity, which can't be represented in JSON, are left
+	 *        to `ToString`
+	 *
+	 */
+	template<typename _OutputIt, typename _FloatType>
+	inline static
+	typename std::enable_if<std::is_floating_point<_FloatType>::value>::type
+	WriteVal(_OutputIt it, const _NumObjType& obj, _FloatType val)
+	{
+		if (!std::isfinite(val))
+		{
+			auto str = obj.ToString();
+			Internal::WriteChars(it, str.data(), str.size());
+			return;
+		}
+
+		char buf[Internal::sk_realFormatBufSize];
+		const char* end = Internal::FormatReal(buf, val);
+		Internal::WriteChars(it, buf, static_cast<size_t>(end - buf));
+	}
+
+	inline static char* FormatInteger(char* buf, int64_t val, std::true_type)
+	{
+		return Internal::FormatInt(buf, val);
+	}
+
+	inline static char* FormatInteger(char* buf, uint64_t val, std::false_type)
+	{
+		return Internal::FormatUInt(buf, val);
+	}
+}; // struct JsonWriterNumValImpl
+
+template<typename _LazyNumType>
+struct JsonWriterLazyNumImpl
+{
+	/**
+	 * @brief Write the raw text of the lazy number as it is, so the number
+	 *        doesn't need to be decoded
+	 *
+	 */
+	template<typename _OutputIt>
+	inline static void Write(_OutputIt it,
+		const _LazyNumType& obj,
+		const WriterConfig&,
+		const WriterStates&)
+	{
+		const auto& raw = obj.GetRaw();
+		Internal::WriteChars(it, raw.data(), raw.size());
+	}
+}; // struct JsonWriterLazyNumImpl
+
+template<typename _DecimalType>
+struct JsonWriterDecimalImpl
+{
+	using CoefType = typename _DecimalType::CoefType;
+
+	/**
+	 * @brief Write the decimal number exactly as it is represented, in the
+	 *        notation it was parsed from (e.g., `1.5E+03` stays `1.5E+03`);
+	 *        for numbers not parsed from text, the fixed-point notation is
+	 *        used, unless the exponent is positive or there are too many
+	 *        leading zeros, in which case the number is written as
+	 *        `<coef>e<exp>`
+	 *
+	 */
+	template<typename _OutputIt>
+	inline static void Write(_OutputIt it,
+		const _DecimalType& obj,
+		const WriterConfig&,
+		const WriterStates&)
+	{
+		// Enough for a 128-bit coefficient
+		char digits[40];
+		size_t numDigits = 0;
+		CoefType coef = obj.GetCoef();
+		do
+		{
+			digits[numDigits++] = static_cast<char>('0' + (coef % 10));
+			coef /= 10;
+		} while (coef != CoefType(0));
+
+		const DecimalNotation& notation = obj.GetNotation();
+		const int64_t exp = obj.GetExp();
+
+		// The exponent written after the mantissa, if there is one
+		bool hasExp = false;
+		int64_t expVal = 0;
+		char expCh = 'e';
+		char expSign = '\0';
+		uint32_t minExpDigits = 1;
+		switch (notation.m_form)
+		{
+		case DecimalNotation::Form::Exp:
+			hasExp = true;
+			expVal = notation.m_exp;
+			expCh = notation.m_expCh;
+			expSign = notation.m_expSign;
+			minExpDigits = notation.m_numExpDigits;
+			break;
+
+		case DecimalNotation::Form::Plain:
+			break;
+
+		default:
+			if (exp > 0 || -exp > static_cast<int64_t>(numDigits) + 6)
+			{
+				// <coef>e<exp>
+				hasExp = true;
+				expVal = exp;
+			}
+			break;
+		}
+		if (expVal < 0)
+		{
+			expSign = '-';
+		}
+
+		// The text is composed here, and written in one go, except for long
+		// runs of zeros; the longest one is `-<40 digits>.`
+		char buf[64];
+		char* ptr = buf;
+
+		if (obj.IsNegative())
+		{
+			*ptr++ = '-';
+		}
+
+		// The mantissa is `coef * 10^mantExp`
+		const int64_t mantExp = exp - expVal;
+		if (mantExp >= 0)
+		{
+			// <coef><zeros>
+			ptr = CopyDigitsRev(ptr, digits, numDigits);
+			Internal::WriteChars(it, buf, static_cast<size_t>(ptr - buf));
+			ptr = buf;
+			WriteZeros(it, static_cast<uint64_t>(mantExp));
+		}
+		else
+		{
+			const uint64_t fracLen = static_cast<uint64_t>(-mantExp);
+			if (fracLen < numDigits)
+			{
+				// <int>.<frac>
+				const size_t intLen = numDigits - static_cast<size_t>(fracLen);
+				ptr = CopyDigitsRev(ptr, digits + fracLen, intLen);
+				*ptr++ = '.';
+				ptr = CopyDigitsRev(ptr, digits, static_cast<size_t>(fracLen));
+			}
+			else
+			{
+				// 0.<zeros><coef>
+				*ptr++ = '0';
+				*ptr++ = '.';
+				Internal::WriteChars(it, buf, static_cast<size_t>(ptr - buf));
+				ptr = buf;
+				WriteZeros(it, fracLen - numDigits);
+				ptr = CopyDigitsRev(ptr, digits, numDigits);
+			}
+		}
+
+		if (hasExp)
+		{
+			*ptr++ = expCh;
+			if (expSign != '\0')
+			{
+				*ptr++ = expSign;
+			}
+
+			uint64_t expAbs = static_cast<uint64_t>(
+				(expVal < 0) ? -expVal : expVal);
+			char expDigits[20];
+			size_t numExpDigits = 0;
+			do
+			{
+				expDigits[numExpDigits++] =
+					static_cast<char>('0' + (expAbs % 10));
+				expAbs /= 10;
+			} while (expAbs != 0);
+
+			// leading zeros of the exponent, as it was written
+			if (minExpDigits > numExpDigits)
+			{
+				Internal::WriteChars(it, buf, static_cast<size_t>(ptr - buf));
+				ptr = buf;
+				WriteZeros(it, minExpDigits - numExpDigits);
+			}
+			ptr = CopyDigitsRev(ptr, expDigits, numExpDigits);
+		}
+
+		Internal::WriteChars(it, buf, static_cast<size_t>(ptr - buf));
+	}
+
+private:
+
+	inline static char* CopyDigitsRev(char* dest,
+		const char* digits, size_t len)
+	{
+		while (len > 0)
+		{
+			*dest++ = digits[--len];
+		}
+		return dest;
+	}
+
+	template<typename _OutputIt>
+	inline static void WriteZeros(_OutputIt& it, uint64_t len)
+	{
+		static constexpr char sk_zeros[] = "0000000000000000";
+		constexpr size_t maxLen = sizeof(sk_zeros) - 1;
+		while (len > 0)
+		{
+			const size_t blockLen = (len < maxLen) ?
+				static_cast<size_t>(len) : maxLen;
+			Internal::WriteChars(it, sk_zeros, blockLen);
+			len -= blockLen;
+		}
+	}
+}; // struct JsonWriterDecimalImpl
+
 } // namespace SimpleJson
@@ -0,0 +1,307 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstdint>
+
+#include <iterator>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "WriterConfig.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A cache of the serialized bytes of immutable subtrees, so a subtree
+ *        that is written again and again (e.g., a large static part of every
+ *        response) is only walked once; later writes copy the bytes instead.
+ *        - Subtrees are identified by their addresses, and must be marked,
+ *          with a generation stamp, by `Mark` to be cached
+ *        - Marking a subtree again with a different generation, or calling
+ *          `Invalidate`, drops its cached bytes; it's the caller's
+ *          responsibility to do so whenever a marked subtree is modified or
+ *          destroyed
+ *        - The bytes depend on the output format (indentation, nesting level,
+ *          etc.), so a subtree may have multiple cached variants
+ *        - The total size of cached bytes is bounded, and the least recently
+ *          used variants are evicted first
+ *        NOTE: this class is *not* thread-safe; use one cache per thread, or
+ *        guard it with a lock
+ *
+ */
+class SerializeCache
+{
+public: // static members:
+
+	static constexpr size_t sk_defaultMaxSize = 16 * 1024 * 1024;
+
+public:
+
+	explicit SerializeCache(size_t maxSize = sk_defaultMaxSize) :
+		m_entries(),
+		m_marks(),
+		m_size(0),
+		m_maxSize(maxSize)
+	{}
+
+	// Entries refer to each other by iterators
+	SerializeCache(const SerializeCache& other) = delete;
+
+	~SerializeCache() = default;
+
+	SerializeCache& operator=(const SerializeCache& other) = delete;
+
+	/**
+	 * @brief Mark a subtree as immutable, so its serialized bytes can be
+	 *        cached; if it's already marked with a different generation,
+	 *        the bytes cached for the old generation are dropped
+	 *
+	 */
+	void Mark(const void* obj, uint64_t generation)
+	{
+		auto it = m_marks.find(obj);
+		if (it == m_marks.end())
+		{
+			m_marks.emplace(obj, MarkInfo(generation));
+		}
+		else if (it->second.m_generation != generation)
+		{
+			DropEntries(it->second);
+			it->second.m_generation = generation;
+		}
+	}
+
+	/**
+	 * @brief Unmark the subtree, and drop all bytes cached for it
+	 *
+	 */
+	void Invalidate(const void* obj)
+	{
+		auto it = m_marks.find(obj);
+		if (it != m_marks.end())
+		{
+			DropEntries(it->second);
+			m_marks.erase(it);
+		}
+	}
+
+	/**
+	 * @brief Unmark all subtrees, and drop all cached bytes
+	 *
+	 */
+	void Clear()
+	{
+		m_entries.clear();
+		m_marks.clear();
+		m_size = 0;
+	}
+
+	bool IsMarked(const void* obj) const
+	{
+		return m_marks.find(obj) != m_marks.end();
+	}
+
+	/**
+	 * @brief Get the generation the subtree is marked with
+	 *
+	 * @return `true` and the generation, or `false` if it's not marked
+	 */
+	std::pair<bool, uint64_t> GetGeneration(const void* obj) const
+	{
+		auto it = m_marks.find(obj);
+		return it == m_marks.end() ?
+			std::make_pair(false, uint64_t(0)) :
+			std::make_pair(true, it->second.m_generation);
+	}
+
+	/**
+	 * @brief Get the total size of cached bytes
+	 *
+	 */
+	size_t GetSize() const
+	{
+		return m_size;
+	}
+
+	size_t GetMaxSize() const
+	{
+		return m_maxSize;
+	}
+
+	/**
+	 * @brief Find the bytes cached for the given subtree, in the given
+	 *        output format
+	 *
+	 * @return a pointer to the bytes, which is valid until the cache is
+	 *         modified, or `nullptr` if it's not found
+	 */
+	const std::string* Find(
+		const void* obj,
+		const WriterConfig& config,
+		bool isPretty,
+		size_t nestLevel)
+	{
+		auto itMark = m_marks.find(obj);
+		if (itMark == m_marks.end())
+		{
+			return nullptr;
+		}
+
+		for (EntryIt entryIt : itMark->second.m_entries)
+		{
+			if (entryIt->Matches(config, isPretty, nestLevel))
+			{
+				// most recently used entries go first
+				m_entries.splice(m_entries.begin(), m_entries, entryIt);
+				return &(entryIt->m_bytes);
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Store the bytes of the given subtree, in the given output
+	 *        format; it's ignored if the subtree is not marked, or the bytes
+	 *        are larger than the maximum size of the cache
+	 *
+	 */
+	void Put(
+		const void* obj,
+		const WriterConfig& config,
+		bool isPretty,
+		size_t nestLevel,
+		std::string bytes)
+	{
+		auto itMark = m_marks.find(obj);
+		if (itMark == m_marks.end() || bytes.size() > m_maxSize)
+		{
+			return;
+		}
+
+		m_size += bytes.size();
+		m_entries.emplace_front(
+			obj, config, isPretty, nestLevel, std::move(bytes));
+		itMark->second.m_entries.push_back(m_entries.begin());
+
+		while (m_size > m_maxSize)
+		{
+			EvictLast();
+		}
+	}
+
+private:
+
+	struct Entry
+	{
+		Entry(
+			const void* obj,
+			const WriterConfig& config,
+			bool isPretty,
+			size_t nestLevel,
+			std::string bytes) :
+			m_obj(obj),
+			m_isPretty(isPretty),
+			m_escapeUnicode(config.m_escapeUnicode),
+			m_bytesEncoding(config.m_bytesEncoding),
+			m_nestLevel(isPretty ? nestLevel : 0),
+			m_indent(isPretty ? config.m_indent : std::string()),
+			m_lineEnd(isPretty ? config.m_lineEnd : std::string()),
+			m_bytes(std::move(bytes))
+		{}
+
+		/**
+		 * @brief Check if the bytes are written in the given format; the
+		 *        compact output doesn't depend on indentation settings
+		 *
+		 */
+		bool Matches(
+			const WriterConfig& config,
+			bool isPretty,
+			size_t nestLevel) const
+		{
+			if ((m_isPretty != isPretty) ||
+				(m_escapeUnicode != config.m_escapeUnicode) ||
+				(m_bytesEncoding != config.m_bytesEncoding))
+			{
+				return false;
+			}
+			return !isPretty ||
+				((m_nestLevel == nestLevel) &&
+				(m_indent == config.m_indent) &&
+				(m_lineEnd == config.m_lineEnd));
+		}
+
+		const void* m_obj;
+		bool m_isPretty;
+		bool m_escapeUnicode;
+		BytesEncoding m_bytesEncoding;
+		size_t m_nestLevel;
+		std::string m_indent;
+		std::string m_lineEnd;
+		std::string m_bytes;
+	}; // struct Entry
+
+	using EntryIt = std::list<Entry>::iterator;
+
+	struct MarkInfo
+	{
+		explicit MarkInfo(uint64_t generation) :
+			m_generation(generation),
+			m_entries()
+		{}
+
+		uint64_t m_generation;
+		std::vector<EntryIt> m_entries;
+	}; // struct MarkInfo
+
+	void DropEntries(MarkInfo& mark)
+	{
+		for (EntryIt entryIt : mark.m_entries)
+		{
+			m_size -= entryIt->m_bytes.size();
+			m_entries.erase(entryIt);
+		}
+		mark.m_entries.clear();
+	}
+
+	void EvictLast()
+	{
+		EntryIt last = std::prev(m_entries.end());
+
+		// the subtree stays marked; only this variant is dropped
+		MarkInfo& mark = m_marks.find(last->m_obj)->second;
+		for (auto it = mark.m_entries.begin();
+			it != mark.m_entries.end();
+			++it)
+		{
+			if (*it == last)
+			{
+				mark.m_entries.erase(it);
+				break;
+			}
+		}
+
+		m_size -= last->m_bytes.size();
+		m_entries.erase(last);
+	}
+
+	std::list<Entry> m_entries;
+	std::unordered_map<const void*, MarkInfo> m_marks;
+	size_t m_size;
+	size_t m_maxSize;
+
+}; // class SerializeCache
+
+} // namespace SimpleJson
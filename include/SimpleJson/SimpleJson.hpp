@@ -18,6 +18,44 @@ inline static Internal::Obj::Object LoadStr(const IMContainerType& str)
 	return parser.ParseTillEnd(str);
 }
 
+/**
+ * @brief Parse a JSON string into a document that owns an arena, from which
+ *        all nodes of the document are allocated, so they are released
+ *        together (see `ArenaDocumentImpl` for what is in the arena)
+ *
+ */
+inline static ArenaDocument LoadStrInArena(
+	const IMContainerType& str,
+	size_t blockSize = Arena::sk_defaultBlockSize)
+{
+	ArenaGenericObjectParser parser;
+	return ArenaDocument::Parse(parser, str, blockSize);
+}
+
+/**
+ * @brief Create a raw JSON fragment, which is parsed once to make sure it's
+ *        a valid JSON value; the parsed result is discarded.
+ *        Whitespace around the value is trimmed, so it doesn't leak into
+ *        the output; the formatting inside the value is kept as it is
+ *
+ * @exception ParseError thrown if the given string is not a valid JSON value
+ */
+inline static RawJson LoadRawJson(IMContainerType str)
+{
+	GenericObjectParser parser;
+	parser.ParseTillEnd(str);
+
+	size_t end = str.size();
+	while (end > 0 && Internal::IsSpaceCh(str[end - 1]))
+	{
+		--end;
+	}
+	str.erase(end);
+	str.erase(str.begin(), Internal::SkipLeadingSpace(str.begin(), str.end()));
+
+	return RawJson(std::move(str));
+}
+
 template<typename _ObjType>
 struct FindObjWriter;
 
@@ -41,18 +79,46 @@ struct FindObjWriter<Internal::Obj::Null>
 template<>
 struct FindObjWriter<Internal::Obj::Bool>
 {
-	using type = JsonWriterRealNum;
+	using type = JsonWriterNumValT<Internal::Obj::Bool>;
 }; // struct FindObjWriter
 
 template<>
-struct FindObjWriter<Internal::Obj::Int64> :
-	public FindObjWriter<Internal::Obj::Bool>
-{}; // struct FindObjWriter
+struct FindObjWriter<Internal::Obj::Int64>
+{
+	using type = JsonWriterNumValT<Internal::Obj::Int64>;
+}; // struct FindObjWriter
 
 template<>
-struct FindObjWriter<Internal::Obj::Double> :
-	public FindObjWriter<Internal::Obj::Bool>
-{}; // struct FindObjWriter
+struct FindObjWriter<Internal::Obj::Double>
+{
+	using type = JsonWriterNumValT<Internal::Obj::Double>;
+}; // struct FindObjWriter
+
+template<>
+struct FindObjWriter<LazyNumber>
+{
+	using type = JsonWriterLazyNum;
+}; // struct FindObjWriter
+
+template<>
+struct FindObjWriter<Decimal>
+{
+	using type = JsonWriterDecimal;
+}; // struct FindObjWriter
+
+#ifdef __SIZEOF_INT128__
+template<>
+struct FindObjWriter<Decimal128>
+{
+	using type = JsonWriterDecimal128;
+}; // struct FindObjWriter
+#endif // __SIZEOF_INT128__
+
+template<>
+struct FindObjWriter<RawJson>
+{
+	using type = JsonWriterRawJson;
+}; // struct FindObjWriter
 
 template<>
 struct FindObjWriter<Internal::Obj::String>
@@ -60,6 +126,31 @@ struct FindObjWriter<Internal::Obj::String>
 	using type = JsonWriterString;
 }; // struct FindObjWriter
 
+template<>
+struct FindObjWriter<Internal::Obj::Bytes>
+{
+	using type = JsonWriterBytes;
+}; // struct FindObjWriter
+
+/**
+ * @brief Lists and dicts of a known item type are written by typed writers,
+ *        which hand items to the item writer directly
+ *
+ */
+template<typename _ValType>
+struct FindObjWriter<Internal::Obj::ListT<_ValType> >
+{
+	using type = JsonWriterTypedListT<
+		_ValType, typename FindObjWriter<_ValType>::type>;
+}; // struct FindObjWriter
+
+template<typename _KeyType, typename _ValType>
+struct FindObjWriter<Internal::Obj::DictT<_KeyType, _ValType> >
+{
+	using type = JsonWriterTypedDictT<
+		_KeyType, _ValType, JsonWriterKey, typename FindObjWriter<_ValType>::type>;
+}; // struct FindObjWriter
+
 template<>
 struct FindObjWriter<Internal::Obj::List>
 {
@@ -72,20 +163,278 @@ struct FindObjWriter<Internal::Obj::Dict>
 	using type = JsonWriterDictT<JsonWriterKey, JsonWriterObject>;
 }; // struct FindObjWriter
 
+/**
+ * @brief Compute the exact number of characters that the object will be
+ *        serialized into, including escapes and indentation, without
+ *        producing the output
+ *
+ */
 template<
 	typename _ObjType,
 	typename _WriterType = typename FindObjWriter<_ObjType>::type>
-inline static ToStringType DumpStr(
+inline static size_t MeasureJson(
+	const _ObjType& obj,
+	WriterConfig config = WriterConfig())
+{
+	size_t size = 0;
+	_WriterType::Write(
+		CountingOutputIterator(size),
+		obj,
+		config,
+		WriterStates()
+	);
+	return size;
+}
+
+/**
+ * @brief Write the object to the given output sink; NOTE: the sink is *not*
+ *        flushed by this function
+ *
+ */
+template<
+	typename _ObjType,
+	typename _WriterType = typename FindObjWriter<_ObjType>::type>
+inline static void DumpToSink(
+	OutputSink& sink,
 	const _ObjType& obj,
 	WriterConfig config = WriterConfig())
 {
-	ToStringType res;
 	_WriterType::Write(
-		std::back_inserter(res),
+		OutputSinkIt(sink),
 		obj,
 		config,
 		WriterStates()
 	);
+}
+
+/**
+ * @brief Write the object to the given output stream, through a fixed-size
+ *        buffer, so the memory usage doesn't depend on the size of the output
+ *
+ */
+template<
+	typename _ObjType,
+	typename _WriterType = typename FindObjWriter<_ObjType>::type>
+inline static void DumpToStream(
+	std::ostream& stream,
+	const _ObjType& obj,
+	WriterConfig config = WriterConfig())
+{
+	StreamOutputSink sink(stream);
+	DumpToSink<_ObjType, _WriterType>(sink, obj, config);
+	sink.Flush();
+}
+
+/**
+ * @brief Write the object to the given C `FILE` stream, through a
+ *        fixed-size buffer
+ *
+ */
+template<
+	typename _ObjType,
+	typename _WriterType = typename FindObjWriter<_ObjType>::type>
+inline static void DumpToFile(
+	std::FILE* file,
+	const _ObjType& obj,
+	WriterConfig config = WriterConfig())
+{
+	FileOutputSink sink(file);
+	DumpToSink<_ObjType, _WriterType>(sink, obj, config);
+	sink.Flush();
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/**
+ * @brief Write the object to the given file descriptor, through a
+ *        fixed-size buffer that is flushed with `write`/`writev` whenever
+ *        it's full
+ *
+ */
+template<
+	typename _ObjType,
+	typename _WriterType = typename FindObjWriter<_ObjType>::type>
+inline static void DumpToFd(
+	int fd,
+	const _ObjType& obj,
+	WriterConfig config = WriterConfig())
+{
+	FdOutputSink sink(fd);
+	DumpToSink<_ObjType, _WriterType>(sink, obj, config);
+	sink.Flush();
+}
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+/**
+ * @brief Write the object into a caller-provided buffer, without any heap
+ *        allocation (e.g., for enclaves, or real-time code paths), except:
+ *        - the escaped keys of a static dict type, which are cached once
+ *          per type (see `JsonWriterStaticDictImpl`)
+ *        - numbers that can't be formatted natively (e.g., NaN), which go
+ *          through `ToString`
+ *        - exceptions thrown on errors
+ *        No null terminator is written.
+ *
+ * @return `true` and the number of characters written; or `false` and the
+ *         size required to hold the whole output, if the buffer is too
+ *         small, in which case the buffer holds a truncated output
+ */
+template<
+	typename _ObjType,
+	typename _WriterType = typename FindObjWriter<_ObjType>::type>
+inline static std::pair<bool, size_t> DumpToBuffer(
+	char* buf,
+	size_t capacity,
+	const _ObjType& obj,
+	const WriterConfig& config = WriterConfig())
+{
+	FixedBuffer dest(buf, capacity);
+	WriterStates state;
+	state.m_isAllocFree = true;
+
+	_WriterType::Write(
+		FixedBufferIterator(dest),
+		obj,
+		config,
+		state
+	);
+	return std::make_pair(!dest.IsOverflow(), dest.GetSize());
+}
+
+template<
+	typename _ObjType,
+	typename _WriterType = typename FindObjWriter<_ObjType>::type>
+inline static ToStringType DumpStr(
+	const _ObjType& obj,
+	WriterConfig config = WriterConfig())
+{
+	ToStringType res;
+	StringOutputSink sink(res);
+	DumpToSink<_ObjType, _WriterType>(sink, obj, config);
+	sink.Flush();
+	return res;
+}
+
+/**
+ * @brief Same as `DumpStr`, but the exact size of the output is measured
+ *        first (see `MeasureJson`), so the string is allocated only once and
+ *        has no spare capacity; NOTE: the writer runs twice, so this is
+ *        slower than `DumpStr`, and it's only worth it when the memory of the
+ *        result matters more than the time spent
+ *
+ */
+template<
+	typename _ObjType,
+	typename _WriterType = typename FindObjWriter<_ObjType>::type>
+inline static ToStringType DumpStrExact(
+	const _ObjType& obj,
+	WriterConfig config = WriterConfig())
+{
+	ToStringType res;
+	res.reserve(MeasureJson<_ObjType, _WriterType>(obj, config));
+	StringOutputSink sink(res);
+	DumpToSink<_ObjType, _WriterType>(sink, obj, config);
+	sink.Flush();
+	return res;
+}
+
+
+/**
+ * @brief Write the objects in the range `[begin, end)` to the given output
+ *        sink as newline-delimited JSON (one compact record per line);
+ *        NOTE: the sink is *not* flushed by this function
+ *
+ * @return the number of records written
+ */
+template<typename _ItType>
+inline static size_t DumpNdJsonToSink(
+	OutputSink& sink,
+	_ItType begin,
+	_ItType end,
+	WriterConfig config = WriterConfig())
+{
+	NdJsonWriter writer(sink, std::move(config));
+	writer.Write(begin, end);
+	return writer.GetCount();
+}
+
+/**
+ * @brief Write the objects in the range `[begin, end)` into one string as
+ *        newline-delimited JSON (one compact record per line)
+ *
+ */
+template<typename _ItType>
+inline static ToStringType DumpNdJsonStr(
+	_ItType begin,
+	_ItType end,
+	WriterConfig config = WriterConfig())
+{
+	ToStringType res;
+	StringOutputSink sink(res);
+	DumpNdJsonToSink(sink, begin, end, std::move(config));
+	sink.Flush();
+	return res;
+}
+
+/**
+ * @brief Write the object into a string, where the bytes of marked subtrees
+ *        are copied from the given cache, or stored into it if they are not
+ *        cached yet
+ *
+ */
+template<
+	typename _ObjType,
+	typename _WriterType = typename FindObjWriter<_ObjType>::type>
+inline static ToStringType DumpStr(
+	const _ObjType& obj,
+	SerializeCache& cache,
+	WriterConfig config = WriterConfig())
+{
+	WriterStates state;
+	state.m_serializeCache = &cache;
+
+	ToStringType res;
+	StringOutputSink sink(res);
+	_WriterType::Write(OutputSinkIt(sink), obj, config, state);
+	sink.Flush();
+	return res;
+}
+
+/**
+ * @brief Write the object into a string, where large lists and dicts are
+ *        serialized on multiple threads; the output is identical to the one
+ *        of `DumpStr`
+ *
+ * @param numThreads The number of threads to use, including the calling
+ *                   thread; 0 means the number of hardware threads
+ */
+inline static ToStringType DumpStrParallel(
+	const JsonWriterParallel::ObjType& obj,
+	WriterConfig config = WriterConfig(),
+	size_t numThreads = 0)
+{
+	ToStringType res;
+	StringOutputSink sink(res);
+	JsonWriterParallel::Write(OutputSinkIt(sink), obj,
+		config, WriterStates(), numThreads);
+	sink.Flush();
+	return res;
+}
+
+/**
+ * @brief Write the object in the canonical form defined by RFC 8785 (JSON
+ *        Canonicalization Scheme), which is suitable for hashing and signing
+ *
+ */
+inline static ToStringType DumpCanonicalStr(
+	const JsonWriterCanonical::ObjType& obj)
+{
+	ToStringType res;
+	StringOutputSink sink(res);
+	JsonWriterCanonical::Write(OutputSinkIt(sink), obj,
+		WriterConfig(), WriterStates());
+	sink.Flush();
 	return res;
 }
 
@@ -0,0 +1,368 @@
+// Copyright (c) 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "NumFormatter.hpp"
+#include "OutputSink.hpp"
+#include "Utils.hpp"
+#include "WriterConfig.hpp"
+
+#ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
+namespace SimpleJson
+#else
+namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A SAX-style writer, which writes JSON straight to an output sink
+ *        through a series of calls (e.g., `StartObject`, `Key`, `Value`,
+ *        `EndObject`), so no object tree needs to be built first.
+ *        The structure is validated as it goes (e.g., a key must be followed
+ *        by a value, and only one root value is allowed), and the output is
+ *        identical to the one produced by the object writers with the same
+ *        configuration.
+ *        NOTE: the sink is *not* flushed by this writer
+ *
+ * @tparam _StrWriter The string writer used to escape strings
+ */
+template<typename _StrWriter>
+class JsonStreamWriterImpl
+{
+public: // static members:
+
+	using StrWriter = _StrWriter;
+	using SinkType = OutputSinkBase<char>;
+	using OutputIt = OutputSinkIterator<char>;
+
+public:
+
+	explicit JsonStreamWriterImpl(
+		SinkType& sink,
+		WriterConfig config = WriterConfig()) :
+		m_sink(sink),
+		m_config(std::move(config)),
+		m_newLineCache(),
+		m_state(),
+		m_frames(),
+		m_hasRoot(false)
+	{
+		m_state.m_newLineCache = &m_newLineCache;
+	}
+
+	// m_state refers to m_newLineCache
+	JsonStreamWriterImpl(const JsonStreamWriterImpl& other) = delete;
+
+	~JsonStreamWriterImpl() = default;
+
+	JsonStreamWriterImpl& operator=(const JsonStreamWriterImpl& other) = delete;
+
+	/**
+	 * @brief Check if a complete root value has been written
+	 *
+	 */
+	bool IsComplete() const
+	{
+		return m_hasRoot && m_frames.empty();
+	}
+
+	void StartObject()
+	{
+		BeginValue();
+		*GetIt()++ = '{';
+		m_frames.push_back(Frame(true));
+	}
+
+	void EndObject()
+	{
+		End(true, '}');
+	}
+
+	void StartArray()
+	{
+		BeginValue();
+		*GetIt()++ = '[';
+		m_frames.push_back(Frame(false));
+	}
+
+	void EndArray()
+	{
+		End(false, ']');
+	}
+
+	void Key(const char* str, size_t len)
+	{
+		if (m_frames.empty() ||
+			!m_frames.back().m_isObject ||
+			m_frames.back().m_hasKey)
+		{
+			throw SerializeValueError("Unexpected key");
+		}
+
+		Frame& frame = m_frames.back();
+		BeginItem(frame);
+		WriteStr(str, len);
+
+		if (IsPretty())
+		{
+			Internal::WriteChars(GetIt(), " : ", 3);
+		}
+		else
+		{
+			*GetIt()++ = ':';
+		}
+		frame.m_hasKey = true;
+	}
+
+	void Key(const std::string& str)
+	{
+		Key(str.data(), str.size());
+	}
+
+	void Key(const char* str)
+	{
+		Key(str, std::strlen(str));
+	}
+
+	void Null()
+	{
+		BeginValue();
+		Internal::WriteChars(GetIt(), "null", 4);
+	}
+
+	void Value(const char* str, size_t len)
+	{
+		BeginValue();
+		WriteStr(str, len);
+	}
+
+	void Value(const std::string& str)
+	{
+		Value(str.data(), str.size());
+	}
+
+	void Value(const char* str)
+	{
+		Value(str, std::strlen(str));
+	}
+
+	void Value(bool val)
+	{
+		BeginValue();
+		if (val)
+		{
+			Internal::WriteChars(GetIt(), "true", 4);
+		}
+		else
+		{
+			Internal::WriteChars(GetIt(), "false", 5);
+		}
+	}
+
+	template<typename _IntType>
+	typename std::enable_if<
+		std::is_integral<_IntType>::value &&
+			!std::is_same<_IntType, bool>::value
+	>::type
+	Value(_IntType val)
+	{
+		BeginValue();
+
+		char buf[Internal::sk_intFormatBufSize];
+		const char* end = FormatInteger(buf, val,
+			std::is_signed<_IntType>());
+		Internal::WriteChars(GetIt(), buf, static_cast<size_t>(end - buf));
+	}
+
+	/**
+	 * @exception SerializeValueError thrown if the value is NaN or infinity,
+	 *                                which can't be represented in JSON
+	 */
+	void Value(double val)
+	{
+		WriteReal(val);
+	}
+
+	/**
+	 * @exception SerializeValueError thrown if the value is NaN or infinity,
+	 *                                which can't be represented in JSON
+	 */
+	void Value(float val)
+	{
+		WriteReal(val);
+	}
+
+	/**
+	 * @brief Write an already serialized JSON value (e.g., a cached payload)
+	 *        as it is; it's the caller's responsibility to make sure it's a
+	 *        single valid JSON value
+	 *
+	 */
+	void RawValue(const char* json, size_t len)
+	{
+		BeginValue();
+		Internal::WriteChars(GetIt(), json, len);
+	}
+
+	void RawValue(const std::string& json)
+	{
+		RawValue(json.data(), json.size());
+	}
+
+private:
+
+	struct Frame
+	{
+		explicit Frame(bool isObject) :
+			m_isObject(isObject),
+			m_hasKey(false),
+			m_count(0)
+		{}
+
+		bool m_isObject;
+		bool m_hasKey;
+		size_t m_count;
+	}; // struct Frame
+
+	static char* FormatInteger(char* buf, int64_t val, std::true_type)
+	{
+		return Internal::FormatInt(buf, val);
+	}
+
+	static char* FormatInteger(char* buf, uint64_t val, std::false_type)
+	{
+		return Internal::FormatUInt(buf, val);
+	}
+
+	OutputIt GetIt()
+	{
+		return OutputIt(m_sink);
+	}
+
+	bool IsPretty() const
+	{
+		return m_config.m_indent.size() > 0;
+	}
+
+	/**
+	 * @brief Write the separator and the indentation before an item of the
+	 *        given container
+	 *
+	 */
+	void BeginItem(Frame& frame)
+	{
+		if (frame.m_count > 0)
+		{
+			*GetIt()++ = ',';
+		}
+		if (IsPretty())
+		{
+			Internal::WriteNewLine(GetIt(), m_config, m_state, m_frames.size());
+		}
+		++(frame.m_count);
+	}
+
+	/**
+	 * @brief Check if a value is allowed at current position, and write
+	 *        what's needed before the value
+	 *
+	 */
+	void BeginValue()
+	{
+		if (m_frames.empty())
+		{
+			if (m_hasRoot)
+			{
+				throw SerializeValueError("Only one root value is allowed");
+			}
+			m_hasRoot = true;
+			return;
+		}
+
+		Frame& frame = m_frames.back();
+		if (frame.m_isObject)
+		{
+			if (!frame.m_hasKey)
+			{
+				throw SerializeValueError("A key is expected in an object");
+			}
+			frame.m_hasKey = false;
+		}
+		else
+		{
+			BeginItem(frame);
+		}
+	}
+
+	void End(bool isObject, char closeCh)
+	{
+		if (m_frames.empty() ||
+			(m_frames.back().m_isObject != isObject) ||
+			m_frames.back().m_hasKey)
+		{
+			throw SerializeValueError(isObject ?
+				"Unexpected end of object" : "Unexpected end of array");
+		}
+
+		const size_t count = m_frames.back().m_count;
+		m_frames.pop_back();
+
+		if (IsPretty() && count > 0)
+		{
+			Internal::WriteNewLine(GetIt(), m_config, m_state, m_frames.size());
+		}
+		*GetIt()++ = closeCh;
+	}
+
+	void WriteStr(const char* str, size_t len)
+	{
+		*GetIt()++ = '\"';
+		if (m_config.m_escapeUnicode)
+		{
+			StrWriter::WriteEscapedUnicode(GetIt(), str, str + len);
+		}
+		else
+		{
+			StrWriter::WriteRawUnicode(GetIt(), str, str + len);
+		}
+		*GetIt()++ = '\"';
+	}
+
+	template<typename _FloatType>
+	void WriteReal(_FloatType val)
+	{
+		if (!std::isfinite(val))
+		{
+			throw SerializeValueError("NaN or infinity");
+		}
+
+		BeginValue();
+
+		char buf[Internal::sk_realFormatBufSize];
+		const char* end = Internal::FormatReal(buf, val);
+		Internal::WriteChars(GetIt(), buf, static_cast<size_t>(end - buf));
+	}
+
+	SinkType& m_sink;
+	WriterConfig m_config;
+	std::string m_newLineCache;
+	WriterStates m_state;
+	std::vector<Frame> m_frames;
+	bool m_hasRoot;
+
+}; // class JsonStreamWriterImpl
+
+} // namespace SimpleJson
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "ParserBase.hpp"
 #include "Internal/SimpleUtf.hpp"
 
@@ -61,12 +63,31 @@ public:
 		return Parse2Obj(ism);
 	}
 
+	using Base::ParseInto;
+
+	/**
+	 * @brief The characters are parsed into the target string in place, so
+	 *        its capacity is reused
+	 *
+	 */
+	virtual void ParseInto(
+		InputStateMachineIf<InputChType>& ism, RetType& target) const override
+	{
+		ParseIntoImpl(ism, target, std::is_same<RetType, ObjType>());
+	}
+
 protected:
 
-	// definition: https://datatracker.ietf.org/doc/html/rfc7159#section-7
 	ObjType Parse2Obj(InputStateMachineIf<InputChType>& ism) const
 	{
 		auto res = ObjType();
+		Parse2Obj(ism, res);
+		return res;
+	}
+
+	// definition: https://datatracker.ietf.org/doc/html/rfc7159#section-7
+	void Parse2Obj(InputStateMachineIf<InputChType>& ism, ObjType& res) const
+	{
 		auto ch = ism.SkipSpaceAndGetCharAndAdv();
 		if (ch == '\"')
 		{
@@ -76,7 +97,7 @@ protected:
 				// Case 1 - ending quote
 				if (ch == '\"') // Ending
 				{
-					return res;
+					return;
 				}
 				// Case 2 - Escape something
 				else if (ch == '\\')
@@ -126,6 +147,19 @@ protected:
 
 private:
 
+	void ParseIntoImpl(InputStateMachineIf<InputChType>& ism,
+		RetType& target, std::true_type) const
+	{
+		target.clear();
+		Parse2Obj(ism, target);
+	}
+
+	void ParseIntoImpl(InputStateMachineIf<InputChType>& ism,
+		RetType& target, std::false_type) const
+	{
+		target = Parse2Obj(ism);
+	}
+
 	char16_t ParseUXXXX(InputStateMachineIf<InputChType>& ism) const
 	{
 		char16_t res = 0;
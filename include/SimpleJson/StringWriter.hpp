@@ -5,6 +5,13 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+
+#include <type_traits>
+
+#include "Exceptions.hpp"
+#include "Utils.hpp"
 #include "WriterConfig.hpp"
 #include "Internal/SimpleObjects.hpp"
 
@@ -21,80 +28,271 @@ struct JsonWriterStringImpl
 
 	using AsciiTraitType = Internal::Utf::AsciiTraits<_CharType>;
 
+	using IsSingleByte = std::integral_constant<bool, sizeof(_CharType) == 1>;
+
 	template<typename OutputIt>
 	static void WriteUXXXX(char16_t val, OutputIt dest)
 	{
-		constexpr char alphabet[] = "0123456789ABCDEF";
+		char buf[4];
+		FillXXXX(val, buf);
 
-		uint8_t nibble = 0;
+		Internal::WriteChars(dest, buf, sizeof(buf));
+	}
 
-		nibble = static_cast<uint8_t>((val >> 12) & 0x0F);
-		*dest++ = *(std::begin(alphabet) + nibble);
+	/**
+	 * @brief Write the entire escape sequence, `\uXXXX`, in one go
+	 *
+	 */
+	template<typename OutputIt>
+	static void WriteEscapedUXXXX(char16_t val, OutputIt dest,
+		bool lowerHex = false)
+	{
+		char buf[6] = { '\\', 'u', };
+		FillXXXX(val, buf + 2, lowerHex);
 
-		nibble = static_cast<uint8_t>((val >>  8) & 0x0F);
-		*dest++ = *(std::begin(alphabet) + nibble);
+		Internal::WriteChars(dest, buf, sizeof(buf));
+	}
 
-		nibble = static_cast<uint8_t>((val >>  4) & 0x0F);
-		*dest++ = *(std::begin(alphabet) + nibble);
+	static void FillXXXX(char16_t val, char* buf, bool lowerHex = false)
+	{
+		const char* alphabet =
+			lowerHex ? "0123456789abcdef" : "0123456789ABCDEF";
 
-		nibble = static_cast<uint8_t>((val >>  0) & 0x0F);
-		*dest++ = *(std::begin(alphabet) + nibble);
+		buf[0] = alphabet[(val >> 12) & 0x0F];
+		buf[1] = alphabet[(val >>  8) & 0x0F];
+		buf[2] = alphabet[(val >>  4) & 0x0F];
+		buf[3] = alphabet[(val >>  0) & 0x0F];
+	}
+
+	/**
+	 * @brief Check if the given ASCII character can be written as it is;
+	 *        i.e., it's not a control character, '"', '\\', or '/'
+	 *
+	 */
+	inline static bool IsPlainAscii(_CharType ch)
+	{
+		switch(ch)
+		{
+		case '"':
+		case '\\':
+		case '/':
+			return false;
+		default:
+			return (ch >= 0x20) && AsciiTraitType::IsAsciiFast(ch);
+		}
 	}
 
 	template<typename _OutputIt>
-	inline static void Write(_OutputIt dest,
-		const Internal::Obj::StringBaseObject<_CharType, _ToStringType>& obj,
-		const WriterConfig&,
-		const WriterStates&)
+	inline static void WriteEscape(_OutputIt dest, _CharType ch)
 	{
-		*dest++ = '\"';
-		auto it = obj.begin();
-		while(it != obj.end())
+		_CharType buf[2] = { '\\', ch };
+
+		switch(ch)
+		{
+		case '\b':
+			buf[1] = 'b';
+			break;
+		case '\f':
+			buf[1] = 'f';
+			break;
+		case '\n':
+			buf[1] = 'n';
+			break;
+		case '\r':
+			buf[1] = 'r';
+			break;
+		case '\t':
+			buf[1] = 't';
+			break;
+		default: // '"', '\\', '/'
+			break;
+		}
+
+		Internal::WriteChars(dest, buf, 2);
+	}
+
+	/**
+	 * @brief Write an ASCII character that needs to be escaped; control
+	 *        characters that have no short escape (e.g., `\n`) are written
+	 *        as `\u00XX`
+	 *
+	 */
+	template<typename _OutputIt>
+	inline static void WriteEscapedAscii(_OutputIt dest, _CharType ch,
+		bool lowerHex = false)
+	{
+		switch(ch)
+		{
+		case '"':
+		case '\\':
+		case '/':
+		case '\b':
+		case '\f':
+		case '\n':
+		case '\r':
+		case '\t':
+			WriteEscape(dest, ch);
+			break;
+
+		default: // other control characters
+			WriteEscapedUXXXX(static_cast<char16_t>(ch), dest, lowerHex);
+			break;
+		}
+	}
+
+	/**
+	 * @brief Check if the given character can be written as it is, when
+	 *        non-ASCII characters are written as raw UTF-8 bytes;
+	 *        i.e., it's not a control character, '"', '\\', or part of a
+	 *        multi-byte sequence
+	 *
+	 */
+	inline static bool IsPlainRawAscii(_CharType ch)
+	{
+		const uint8_t u = static_cast<uint8_t>(ch);
+		return (0x20 <= u) && (u < 0x80) && (u != '"') && (u != '\\');
+	}
+
+	/**
+	 * @brief Get the length of the valid UTF-8 sequence starting at `it`
+	 *
+	 * @return the length of the sequence, or 0 if it's invalid
+	 *         (e.g., truncated, overlong, or a surrogate code point)
+	 */
+	inline static size_t ValidUtf8SeqLen(
+		const _CharType* it, const _CharType* end)
+	{
+		const uint8_t lead = static_cast<uint8_t>(*it);
+		// valid range of the second byte
+		uint8_t lo = 0x80;
+		uint8_t hi = 0xBF;
+		size_t len = 0;
+
+		if (0xC2 <= lead && lead <= 0xDF)
+		{
+			len = 2;
+		}
+		else if (0xE0 <= lead && lead <= 0xEF)
+		{
+			len = 3;
+			lo = (lead == 0xE0) ? 0xA0 : lo; // overlong
+			hi = (lead == 0xED) ? 0x9F : hi; // surrogates
+		}
+		else if (0xF0 <= lead && lead <= 0xF4)
+		{
+			len = 4;
+			lo = (lead == 0xF0) ? 0x90 : lo; // overlong
+			hi = (lead == 0xF4) ? 0x8F : hi; // > U+10FFFF
+		}
+		else
+		{
+			return 0;
+		}
+
+		if (static_cast<size_t>(end - it) < len)
+		{
+			return 0;
+		}
+
+		const uint8_t second = static_cast<uint8_t>(it[1]);
+		if (second < lo || hi < second)
+		{
+			return 0;
+		}
+		for (size_t i = 2; i < len; ++i)
+		{
+			if ((static_cast<uint8_t>(it[i]) & 0xC0) != 0x80)
+			{
+				return 0;
+			}
+		}
+
+		return len;
+	}
+
+	/**
+	 * @brief Skip the characters that can be written as they are, eight
+	 *        characters at a time (SWAR); it stops at the block containing
+	 *        '"', '\\', a control character, a non-ASCII character, or '/'
+	 *        if `escapeSlash` is true, and the rest is left to the caller
+	 *
+	 */
+	inline static const _CharType* SkipPlainBlocks(
+		const _CharType* it, const _CharType* end, bool escapeSlash,
+		std::true_type)
+	{
+		constexpr uint64_t ones  = 0x0101010101010101ULL;
+		constexpr uint64_t highs = 0x8080808080808080ULL;
+
+		while ((end - it) >= 8)
 		{
+			uint64_t block = 0;
+			std::memcpy(&block, it, sizeof(block));
+
+			const uint64_t quote = block ^ (ones * '"');
+			const uint64_t bSlash = block ^ (ones * '\\');
+
+			uint64_t mask =
+				block |                              // non-ASCII
+				((block - (ones * 0x20)) & ~block) | // control characters
+				((quote - ones) & ~quote) |          // '"'
+				((bSlash - ones) & ~bSlash);         // '\\'
+			if (escapeSlash)
+			{
+				const uint64_t slash = block ^ (ones * '/');
+				mask |= ((slash - ones) & ~slash);
+			}
+
+			if ((mask & highs) != 0)
+			{
+				break;
+			}
+			it += 8;
+		}
+		return it;
+	}
+
+	inline static const _CharType* SkipPlainBlocks(
+		const _CharType* it, const _CharType*, bool,
+		std::false_type)
+	{
+		return it;
+	}
+
+	/**
+	 * @brief Write the string, where all non-ASCII characters are escaped
+	 *        into `\uXXXX`, so the output is pure ASCII
+	 *
+	 */
+	template<typename _OutputIt>
+	inline static void WriteEscapedUnicode(_OutputIt dest,
+		const _CharType* it, const _CharType* end)
+	{
+		while(it != end)
+		{
+			// write the longest run of characters that need no escape
+			const _CharType* runBegin = it;
+			it = SkipPlainBlocks(it, end, true, IsSingleByte());
+			while(it != end && IsPlainAscii(*it))
+			{
+				++it;
+			}
+			if (it != runBegin)
+			{
+				Internal::WriteChars(dest, runBegin,
+					static_cast<size_t>(it - runBegin));
+			}
+
+			if (it == end)
+			{
+				break;
+			}
+
 			auto ch = (*it);
 			if(AsciiTraitType::IsAsciiFast(ch))
 			{
-				// ASCII code
-				switch(ch)
-				{
-				// escape
-				case '"':
-					*dest++ = '\\';
-					*dest++ = '\"';
-					break;
-				case '\\':
-					*dest++ = '\\';
-					*dest++ = '\\';
-					break;
-				case '/':
-					*dest++ = '\\';
-					*dest++ = '/';
-					break;
-				case '\b':
-					*dest++ = '\\';
-					*dest++ = 'b';
-					break;
-				case '\f':
-					*dest++ = '\\';
-					*dest++ = 'f';
-					break;
-				case '\n':
-					*dest++ = '\\';
-					*dest++ = 'n';
-					break;
-				case '\r':
-					*dest++ = '\\';
-					*dest++ = 'r';
-					break;
-				case '\t':
-					*dest++ = '\\';
-					*dest++ = 't';
-					break;
-
-				// default ASCII character
-				default:
-					*dest++ = ch;
-				}
+				// ASCII code that needs to be escaped
+				WriteEscapedAscii(dest, ch);
 				++it;
 			}
 			else
@@ -117,22 +315,99 @@ struct JsonWriterStringImpl
 						tmp.begin(), tmp.end()).first,
 					std::begin(pair));
 
-				*dest++ = '\\';
-				*dest++ = 'u';
-
-				WriteUXXXX(pair[0], dest);
+				WriteEscapedUXXXX(pair[0], dest);
 
 				if (Internal::Utf::Internal::IsUtf16SurrogateFirst(pair[0]))
 				{
-					*dest++ = '\\';
-					*dest++ = 'u';
-
-					WriteUXXXX(pair[1], dest);
+					WriteEscapedUXXXX(pair[1], dest);
 				}
 
 				++it;
 			}
 		}
+	}
+
+	/**
+	 * @brief Write the string, where valid UTF-8 sequences are written as
+	 *        they are, and only the characters required by RFC 8259 are
+	 *        escaped (i.e., '"', '\\', and control characters)
+	 *
+	 * @param lowerHex Whether or not to use lowercase hex digits when other
+	 *                 control characters are written as `\u00XX`
+	 *
+	 * @exception SerializeValueError thrown if the string is not a valid
+	 *                                UTF-8 string
+	 */
+	template<typename _OutputIt>
+	inline static void WriteRawUnicode(_OutputIt dest,
+		const _CharType* it, const _CharType* end, bool lowerHex = false)
+	{
+		while(it != end)
+		{
+			// write the longest run of plain ASCII characters and valid
+			// UTF-8 sequences
+			const _CharType* runBegin = it;
+			while(it != end)
+			{
+				it = SkipPlainBlocks(it, end, false, IsSingleByte());
+				if (it == end)
+				{
+					break;
+				}
+
+				if (IsPlainRawAscii(*it))
+				{
+					++it;
+				}
+				else if (static_cast<uint8_t>(*it) >= 0x80)
+				{
+					size_t seqLen = ValidUtf8SeqLen(it, end);
+					if (seqLen == 0)
+					{
+						throw SerializeValueError("Invalid UTF-8 string");
+					}
+					it += seqLen;
+				}
+				else
+				{
+					break;
+				}
+			}
+			if (it != runBegin)
+			{
+				Internal::WriteChars(dest, runBegin,
+					static_cast<size_t>(it - runBegin));
+			}
+
+			if (it == end)
+			{
+				break;
+			}
+
+			// ASCII code that needs to be escaped
+			WriteEscapedAscii(dest, (*it), lowerHex);
+			++it;
+		}
+	}
+
+	template<typename _OutputIt>
+	inline static void Write(_OutputIt dest,
+		const Internal::Obj::StringBaseObject<_CharType, _ToStringType>& obj,
+		const WriterConfig& config,
+		const WriterStates&)
+	{
+		*dest++ = '\"';
+
+		const _CharType* begin = obj.c_str();
+		const _CharType* end = begin + obj.size();
+		if (config.m_escapeUnicode)
+		{
+			WriteEscapedUnicode(dest, begin, end);
+		}
+		else
+		{
+			WriteRawUnicode(dest, begin, end);
+		}
 
 		*dest++ = '\"';
 
@@ -5,8 +5,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iterator>
 
+#include "OutputSink.hpp"
+#include "WriterConfig.hpp"
+
 #ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
 namespace SimpleJson
 #else
@@ -56,7 +60,45 @@ inline void RepeatOutput(_OutIt out, _InIt begin, _InIt end, size_t repTime)
 template<typename _OutIt, typename _Container>
 inline void RepeatOutput(_OutIt out, const _Container& ctn, size_t repTime)
 {
-	RepeatOutput(out, ctn.begin(), ctn.end(), repTime);
+	for (size_t i = 0; i < repTime; ++i)
+	{
+		WriteChars(out, ctn.data(), ctn.size());
+	}
+}
+
+/**
+ * @brief Write a line end followed by `level` indents, in a single block;
+ *        or piece by piece, if `state.m_newLineCache` is null
+ *
+ */
+template<typename _OutIt>
+inline void WriteNewLine(_OutIt out,
+	const WriterConfig& config, const WriterStates& state, size_t level)
+{
+	if (state.m_newLineCache == nullptr)
+	{
+		WriteChars(out, config.m_lineEnd.data(), config.m_lineEnd.size());
+		RepeatOutput(out, config.m_indent, level);
+		return;
+	}
+
+	std::string& cache = *(state.m_newLineCache);
+	const size_t len =
+		config.m_lineEnd.size() + (config.m_indent.size() * level);
+
+	if (cache.size() < len)
+	{
+		if (cache.empty())
+		{
+			cache = config.m_lineEnd;
+		}
+		while (cache.size() < len)
+		{
+			cache += config.m_indent;
+		}
+	}
+
+	WriteChars(out, cache.data(), len);
 }
 
 } // namespace Internal
@@ -7,6 +7,8 @@
 
 #include <string>
 
+#include "BytesEncoding.hpp"
+
 #ifndef SIMPLEJSON_CUSTOMIZED_NAMESPACE
 namespace SimpleJson
 #else
@@ -14,12 +16,16 @@ namespace SIMPLEJSON_CUSTOMIZED_NAMESPACE
 #endif
 {
 
+class SerializeCache;
+
 // Configurations for the writer
 struct WriterConfig
 {
 	WriterConfig() :
 		m_indent(""),
-		m_lineEnd("\n")
+		m_lineEnd("\n"),
+		m_escapeUnicode(true),
+		m_bytesEncoding(BytesEncoding::None)
 	{}
 
 	~WriterConfig() = default;
@@ -27,22 +33,93 @@ struct WriterConfig
 	std::string m_indent;
 	std::string m_lineEnd;
 
+	/**
+	 * @brief Whether or not to escape all non-ASCII characters into
+	 *        `\uXXXX`; if it's false, valid UTF-8 sequences are written as
+	 *        they are, and only characters required by RFC 8259 are escaped
+	 *
+	 */
+	bool m_escapeUnicode;
+
+	/**
+	 * @brief How bytes objects are written; by default, they can't be
+	 *        serialized, since JSON has no binary type
+	 *
+	 */
+	BytesEncoding m_bytesEncoding;
+
 }; // struct WriterConfig
 
 struct WriterStates
 {
 	WriterStates() :
-		m_nestLevel(0)
+		m_nestLevel(0),
+		m_newLineCache(nullptr),
+		m_serializeCache(nullptr),
+		m_isAllocFree(false)
 	{}
 
 	WriterStates(const WriterStates& other) :
-		m_nestLevel(other.m_nestLevel)
+		m_nestLevel(other.m_nestLevel),
+		m_newLineCache(other.m_newLineCache),
+		m_serializeCache(other.m_serializeCache),
+		m_isAllocFree(other.m_isAllocFree)
 	{}
 
 	~WriterStates() = default;
 
 	size_t m_nestLevel;
 
+	/**
+	 * @brief A line end followed by indents, so a new line with any level
+	 *        of indentation is a prefix of it; it's owned by the outermost
+	 *        container writer, and shared by all nested levels
+	 *
+	 */
+	std::string* m_newLineCache;
+
+	/**
+	 * @brief The cache of serialized bytes of immutable subtrees, which is
+	 *        optional, and owned by the caller
+	 *
+	 */
+	SerializeCache* m_serializeCache;
+
+	/**
+	 * @brief Whether or not to avoid heap allocations; if it's true, no
+	 *        new line cache is created by container writers, and new lines
+	 *        are written piece by piece instead
+	 *
+	 */
+	bool m_isAllocFree;
+
 }; // struct WriterStates
 
+/**
+ * @brief Writer policy that writes pretty (indented) output if
+ *        `WriterConfig::m_indent` is set, or compact output otherwise
+ *
+ */
+struct PrettyWriterPolicy
+{
+	static bool IsPretty(const WriterConfig& config)
+	{
+		return config.m_indent.size() > 0;
+	}
+}; // struct PrettyWriterPolicy
+
+/**
+ * @brief Writer policy that always writes compact output; the indentation
+ *        settings in `WriterConfig` are ignored, and all indentation branches
+ *        are removed at compile time
+ *
+ */
+struct CompactWriterPolicy
+{
+	static constexpr bool IsPretty(const WriterConfig&)
+	{
+		return false;
+	}
+}; // struct CompactWriterPolicy
+
 } // namespace SimpleJson
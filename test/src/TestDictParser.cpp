@@ -254,3 +254,25 @@ GTEST_TEST(TestDictParser, DictKeyParser)
 		EXPECT_EQ(res, expRes);
 	}
 }
+
+GTEST_TEST(TestDictParser, ParseInto)
+{
+	using namespace Internal::Obj;
+	using ResType = DictT<HashableObject, String>;
+
+	DictParserT<StringParser> parser;
+	ResType res;
+
+	// dicts are replaced as a whole
+	parser.ParseTillEndInto("{\"a\" : \"b\", \"c\" : \"d\"}", res);
+	EXPECT_EQ(res, ResType({
+		{ String("a"), String("b") }, { String("c"), String("d") } }));
+
+	parser.ParseTillEndInto(
+		"{\"c\" : \"e\", \"a\" : \"f\", \"c\" : \"g\"}", res);
+	EXPECT_EQ(res, ResType({
+		{ String("c"), String("g") }, { String("a"), String("f") } }));
+
+	parser.ParseTillEndInto("{}", res);
+	EXPECT_EQ(res, ResType());
+}
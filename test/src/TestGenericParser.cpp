@@ -189,3 +189,143 @@ GTEST_TEST(TestGenericParser, ParseError)
 		);
 	}
 }
+
+GTEST_TEST(TestGenericParser, ParseInto)
+{
+	using namespace Internal::Obj;
+
+	GenericObjectParser parser;
+	Object obj;
+
+	const std::string longStr(64, 'x');
+	parser.ParseTillEndInto(
+		"[\"" + longStr + "\", [1, \"" + longStr + "\"]]", obj);
+	EXPECT_EQ(obj, Object(List({
+		String(longStr),
+		List({ Int64(1), String(longStr) }),
+	})));
+
+	auto& list = dynamic_cast<List&>(obj.AsList());
+	auto& str = dynamic_cast<String&>(list[0].AsString());
+	auto& innerList = dynamic_cast<List&>(list[1].AsList());
+	auto& innerStr = dynamic_cast<String&>(innerList[1].AsString());
+	const char* strData = str.data();
+	const size_t strCap = str.capacity();
+	const size_t innerCap = innerList.capacity();
+	const char* innerStrData = innerStr.data();
+
+	// same shape; all nodes are reused
+	parser.ParseTillEndInto("[\"a\", [2, \"b\"]]", obj);
+	EXPECT_EQ(obj, Object(List({
+		String("a"),
+		List({ Int64(2), String("b") }),
+	})));
+	EXPECT_EQ(&dynamic_cast<List&>(obj.AsList()), &list);
+	EXPECT_EQ(str.data(), strData);
+	EXPECT_EQ(str.capacity(), strCap);
+	EXPECT_EQ(innerList.capacity(), innerCap);
+	EXPECT_EQ(innerStr.data(), innerStrData);
+
+	// a top-level string is reused as well
+	Object strObj = String(longStr);
+	const char* strObjData = strObj.AsString().data();
+	parser.ParseTillEndInto("\"c\"", strObj);
+	EXPECT_EQ(strObj, Object(String("c")));
+	EXPECT_EQ(strObj.AsString().data(), strObjData);
+
+	// dicts, and nodes of another category, are replaced
+	parser.ParseTillEndInto("[\"s\", {}]", obj);
+	EXPECT_EQ(obj, Object(List({ String("s"), Dict() })));
+	parser.ParseTillEndInto("[null, {\"a\" : true}]", obj);
+	EXPECT_EQ(obj, Object(List({ Null(), Dict({ { String("a"), Bool(true) } }) })));
+	parser.ParseTillEndInto("{\"a\" : [\"b\"]}", obj);
+	EXPECT_EQ(obj, Object(Dict({ { String("a"), List({ String("b") }) } })));
+	parser.ParseTillEndInto("1.5", obj);
+	EXPECT_EQ(obj, Object(Double(1.5)));
+}
+
+GTEST_TEST(TestGenericParser, LazyNumberParser)
+{
+	using namespace Internal::Obj;
+
+	LazyGenericObjectParser parser;
+	{
+		Object obj = parser.ParseTillEnd(" 1.50E+2 ");
+		EXPECT_TRUE(obj.AsRealNum().GetNumType() == RealNumType::Double);
+		EXPECT_EQ(obj.AsRealNum().AsCppDouble(), 150.0);
+		EXPECT_EQ(obj.AsRealNum().ToString(), "1.50E+2");
+	}
+	{
+		Object obj = parser.ParseTillEnd("-0");
+		EXPECT_TRUE(obj.AsRealNum().GetNumType() == RealNumType::Int64);
+		EXPECT_EQ(obj.AsRealNum().AsCppInt64(), 0);
+		EXPECT_EQ(obj.AsRealNum().ToString(), "-0");
+
+		// the text is kept in copies
+		Object copy = obj;
+		EXPECT_EQ(copy.AsRealNum().ToString(), "-0");
+	}
+	{
+		Object obj = parser.ParseTillEnd("[123, {\"a\" : 4.5}]");
+		EXPECT_EQ(obj.AsList().size(), 2);
+		EXPECT_EQ(DumpStr(obj), "[123,{\"a\":4.5}]");
+	}
+}
+
+static size_t ArenaNodeSize(size_t size)
+{
+	size += sizeof(Internal::ArenaNodeHeader);
+	return ((size + Arena::sk_align - 1) / Arena::sk_align) * Arena::sk_align;
+}
+
+GTEST_TEST(TestGenericParser, ArenaParser)
+{
+	using namespace Internal::Obj;
+
+	const std::string testInput =
+		"{\"a\" : [1, 2.5, null, true, \"s\"], \"b\" : {}}";
+	const Object expRes = Dict({
+		{ String("a"), List({
+			Int64(1), Double(2.5), Null(), Bool(true), String("s") }) },
+		{ String("b"), Dict() },
+	});
+
+	{
+		ArenaDocument doc = LoadStrInArena(testInput, 4096);
+		const Object& obj = doc.GetRoot();
+		EXPECT_EQ(obj, expRes);
+		EXPECT_EQ(DumpStr(obj), "{\"a\":[1,2.5,null,true,\"s\"],\"b\":{}}");
+
+		// all nodes are in one block of the arena
+		EXPECT_EQ(doc.GetArena().GetBlockCount(), 1);
+		const size_t usedSize = doc.GetArena().GetUsedSize();
+		EXPECT_GT(usedSize, 0);
+
+		// copies come from the heap
+		Object copy = obj;
+		EXPECT_EQ(copy, expRes);
+		EXPECT_EQ(doc.GetArena().GetUsedSize(), usedSize);
+
+		// the document can be moved, along with its arena
+		ArenaDocument movedDoc = std::move(doc);
+		EXPECT_EQ(movedDoc.GetRoot(), expRes);
+		EXPECT_EQ(movedDoc.GetArena().GetUsedSize(), usedSize);
+	}
+
+	// each node is allocated once, rather than once per level of nesting
+	{
+		ArenaDocument doc = LoadStrInArena("[[[[1]]]]");
+		EXPECT_EQ(DumpStr(doc.GetRoot()), "[[[[1]]]]");
+		EXPECT_EQ(
+			doc.GetArena().GetUsedSize(),
+			(4 * ArenaNodeSize(sizeof(ArenaListT<Object>))) +
+				ArenaNodeSize(sizeof(ArenaInt64)));
+	}
+
+	// large requests get their own block
+	Arena arena(4096);
+	EXPECT_NE(arena.Allocate(16), nullptr);
+	EXPECT_EQ(arena.GetBlockCount(), 1);
+	EXPECT_NE(arena.Allocate(8192), nullptr);
+	EXPECT_EQ(arena.GetBlockCount(), 2);
+}
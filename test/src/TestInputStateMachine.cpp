@@ -493,4 +493,48 @@ GTEST_TEST(TestInputStateMachine, ForwardItExpDelimiter)
 		EXPECT_EQ(ism1.GetLineCount(), 0);
 		EXPECT_EQ(ism1.GetColCount(), 1);
 	}
-}
\ No newline at end of file
+}
+
+GTEST_TEST(TestInputStateMachine, ForwardItBlock)
+{
+	// type-erased iterator doesn't have contiguous block
+	{
+		using ISMType = ForwardIteratorStateMachine<FrIterator<char, true> >;
+
+		std::string testInput = "0123456789";
+		ISMType ism1(
+			ToFrIt<true>(testInput.cbegin()),
+			ToFrIt<true>(testInput.cend()));
+		EXPECT_EQ(ism1.GetBlock().first, nullptr);
+		EXPECT_EQ(ism1.GetBlock().second, nullptr);
+
+		ism1.AdvanceInLine(8);
+		EXPECT_EQ(ism1.GetChar(), '8');
+		EXPECT_EQ(ism1.GetLineCount(), 0);
+		EXPECT_EQ(ism1.GetColCount(), 8);
+	}
+
+	// raw pointer has contiguous block
+	{
+		using ISMType = ForwardIteratorStateMachine<const char*>;
+
+		std::string testInput = "0123456789";
+		ISMType ism1(
+			testInput.data(),
+			testInput.data() + testInput.size());
+		EXPECT_EQ(ism1.GetBlock().first, testInput.data());
+		EXPECT_EQ(ism1.GetBlock().second,
+			testInput.data() + testInput.size());
+
+		ism1.AdvanceInLine(8);
+		EXPECT_EQ(ism1.GetChar(), '8');
+		EXPECT_EQ(ism1.GetLineCount(), 0);
+		EXPECT_EQ(ism1.GetColCount(), 8);
+		EXPECT_EQ(ism1.GetBlock().first, testInput.data() + 8);
+
+		ism1.AdvanceInLine(2);
+		EXPECT_TRUE(ism1.IsEnd());
+		EXPECT_THROW(ism1.GetChar(), ParseError);
+		EXPECT_EQ(ism1.GetColCount(), 10);
+	}
+}
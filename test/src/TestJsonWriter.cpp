@@ -3,6 +3,20 @@
 // license that can be found in the LICENSE file or at
 // https://opensource.org/licenses/MIT.
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <SimpleJson/SimpleJson.hpp>
@@ -87,6 +101,191 @@ GTEST_TEST(TestJsonWriter, NumWriter)
 			cfg, WriterStates());
 		EXPECT_EQ(res, "0.0");
 	}
+
+	EXPECT_EQ(DumpStr(Internal::Obj::Double(0.1)), "0.1");
+	EXPECT_EQ(DumpStr(Internal::Obj::Double(-0.0)), "-0.0");
+	EXPECT_EQ(DumpStr(Internal::Obj::Double(-123.456)), "-123.456");
+	EXPECT_EQ(DumpStr(Internal::Obj::Double(0.0001)), "0.0001");
+	EXPECT_EQ(DumpStr(Internal::Obj::Double(0.00001)), "1e-5");
+	EXPECT_EQ(DumpStr(Internal::Obj::Double(1e15)), "1e15");
+	EXPECT_EQ(DumpStr(Internal::Obj::Double(123456789012345.0)),
+		"123456789012345.0");
+	EXPECT_EQ(DumpStr(Internal::Obj::Double(1.7976931348623157e308)),
+		"1.7976931348623157e308");
+	EXPECT_EQ(DumpStr(Internal::Obj::Double(5e-324)), "5e-324");
+}
+
+GTEST_TEST(TestJsonWriter, IntFormatter)
+{
+	char buf[Internal::sk_intFormatBufSize];
+
+	for (uint64_t val : std::vector<uint64_t>({
+		0ULL, 7ULL, 10ULL, 99ULL, 100ULL, 9999ULL, 10000ULL, 12345678ULL,
+		1000000000000000000ULL, 18446744073709551615ULL, }))
+	{
+		char* end = Internal::FormatUInt(buf, val);
+		EXPECT_EQ(std::string(buf, end), std::to_string(val));
+	}
+
+	for (int64_t val : std::vector<int64_t>({
+		0LL, -1LL, 42LL, -100LL, 1234567890123LL,
+		std::numeric_limits<int64_t>::max(),
+		std::numeric_limits<int64_t>::min(), }))
+	{
+		char* end = Internal::FormatInt(buf, val);
+		EXPECT_EQ(std::string(buf, end), std::to_string(val));
+	}
+
+	EXPECT_EQ(DumpStr(Internal::Obj::Int64(-9223372036854775807LL - 1)),
+		"-9223372036854775808");
+
+	std::string res;
+	JsonWriterRealNum::Write(
+		std::back_inserter(res),
+		Internal::Obj::UInt64(18446744073709551615ULL),
+		WriterConfig(), WriterStates());
+	EXPECT_EQ(res, "18446744073709551615");
+}
+
+GTEST_TEST(TestJsonWriter, RealNumFormatter)
+{
+	char buf[Internal::sk_realFormatBufSize];
+
+	{
+		char* end = Internal::FormatReal(buf, 0.1f);
+		EXPECT_EQ(std::string(buf, end), "0.1");
+
+		end = Internal::FormatReal(buf, 16777216.0f);
+		EXPECT_EQ(std::string(buf, end), "1.6777216e7");
+	}
+
+	// round-trip
+	std::mt19937_64 rng(12345);
+	for (size_t i = 0; i < 100000; ++i)
+	{
+		uint64_t bits = rng();
+		double val = 0.0;
+		std::memcpy(&val, &bits, sizeof(val));
+		if (!std::isfinite(val))
+		{
+			continue;
+		}
+
+		char* end = Internal::FormatReal(buf, val);
+		std::string str(buf, end);
+		EXPECT_EQ(strtod(str.c_str(), nullptr), val) << str;
+	}
+}
+
+GTEST_TEST(TestJsonWriter, LazyNumWriter)
+{
+	{
+		std::string res;
+		WriterConfig cfg;
+
+		JsonWriterLazyNum::Write(
+			std::back_inserter(res),
+			LazyNumber("0.10000000000000000555", false),
+			cfg, WriterStates());
+		EXPECT_EQ(res, "0.10000000000000000555");
+	}
+
+	{
+		auto num = LazyNumberParser().ParseTillEnd("-1.5e-300");
+		EXPECT_EQ(DumpStr(num), "-1.5e-300");
+	}
+
+	// written back byte for byte
+	for (const std::string testInput : { "1E+5", "-0.0E-0" })
+	{
+		auto num = LazyNumberParser().ParseTillEnd(testInput);
+		EXPECT_EQ(DumpStr(num), testInput);
+	}
+
+	// lazy numbers held by generic objects
+	{
+		const std::string testInput =
+			"{\"a\":[1E+5,-0,0,1.50,0.10000000000000000555,-1.5e-300,7],"
+			"\"b\":99999999999999999999}";
+		auto obj = LazyGenericObjectParser().ParseTillEnd(testInput);
+		EXPECT_EQ(DumpStr(obj), testInput);
+		EXPECT_EQ(MeasureJson(obj), testInput.size());
+	}
+}
+
+GTEST_TEST(TestJsonWriter, DecimalWriter)
+{
+	{
+		std::string res;
+		WriterConfig cfg;
+
+		JsonWriterDecimal::Write(
+			std::back_inserter(res),
+			Decimal(true, 1990, -2),
+			cfg, WriterStates());
+		EXPECT_EQ(res, "-19.90");
+	}
+
+	EXPECT_EQ(DumpStr(Decimal()), "0");
+	EXPECT_EQ(DumpStr(Decimal(false, 5, -3)), "0.005");
+	EXPECT_EQ(DumpStr(Decimal(false, 15, -10)), "15e-10");
+	EXPECT_EQ(DumpStr(Decimal(true, 15, 3)), "-15e3");
+
+	for (const std::string& testInput : std::vector<std::string>({
+		"0.10000000000000000555",
+		"18446744073709551615",
+		"-0.0",
+		"1.50",
+		"123456.000001",
+		"1.5e3",
+		"0.00000001",
+		"1e-8",
+		"1.5E+03",
+		"-0.0E-0",
+		"0e5",
+		"0.5e1",
+		"-12.34e-0056",
+		"0." + std::string(100, '0') + "1",
+		"1" + std::string(18, '0'),
+		"1e" + std::string(30, '0') + "1",
+	}))
+	{
+		auto num = DecimalParser().ParseTillEnd(testInput);
+		EXPECT_EQ(DumpStr(num), testInput);
+		EXPECT_EQ(MeasureJson(num), testInput.size());
+	}
+}
+
+GTEST_TEST(TestJsonWriter, RawJsonWriter)
+{
+	const std::string payload = "{\"a\" : [1, 2.50, \"\\u00e9\"]}";
+
+	RawJson raw = LoadRawJson(payload);
+	EXPECT_EQ(raw.GetJson(), payload);
+	EXPECT_EQ(DumpStr(raw), payload);
+	EXPECT_EQ(MeasureJson(raw), payload.size());
+	EXPECT_EQ(DumpStr(RawJson()), "null");
+
+	// surrounding whitespace is trimmed, internal formatting is kept
+	EXPECT_EQ(LoadRawJson(" \r\n\t" + payload + "\n ").GetJson(), payload);
+	EXPECT_EQ(DumpStr(LoadRawJson("\n[1,\n 2]\n")), "[1,\n 2]");
+
+	EXPECT_THROW(LoadRawJson("{\"a\" : [1, 2}");, ParseError);
+	EXPECT_THROW(LoadRawJson("1 2");, ParseError);
+
+	// envelope
+	std::string res;
+	StringOutputSink sink(res);
+	JsonStreamWriter writer(sink);
+	writer.StartObject();
+	writer.Key("id");
+	writer.Value(1);
+	writer.Key("payload");
+	writer.RawValue(raw.GetJson());
+	writer.EndObject();
+	EXPECT_THROW(writer.RawValue("1", 1);, SerializeValueError);
+	sink.Flush();
+	EXPECT_EQ(res, "{\"id\":1,\"payload\":" + payload + "}");
 }
 
 GTEST_TEST(TestJsonWriter, StringWriter)
@@ -119,6 +318,14 @@ GTEST_TEST(TestJsonWriter, StringWriter)
 
 		res = "";
 
+		JsonWriterString::Write(
+			std::back_inserter(res),
+			Internal::Obj::String("\x01 \x1f \x7f"),
+			cfg, st);
+		EXPECT_EQ(res, "\"\\u0001 \\u001F \x7f\"");
+
+		res = "";
+
 		JsonWriterString::Write(
 			std::back_inserter(res),
 			Internal::Obj::String("\xf0\x9f\x98\x86"),
@@ -135,6 +342,287 @@ GTEST_TEST(TestJsonWriter, StringWriter)
 	}
 }
 
+GTEST_TEST(TestJsonWriter, StringWriterRawUnicode)
+{
+	WriterConfig cfg;
+	cfg.m_escapeUnicode = false;
+
+	EXPECT_EQ(
+		DumpStr(Internal::Obj::String("\" \\ / \b \f \n \r \t \x01 \x1f \x7f"), cfg),
+		"\"\\\" \\\\ / \\b \\f \\n \\r \\t \\u0001 \\u001F \x7f\"");
+	EXPECT_EQ(
+		DumpStr(Internal::Obj::String(
+			"a\xe6\xb5\x8b\xe8\xaf\x95" "b\xf0\x9f\x98\x86\xc2\xa9"), cfg),
+		"\"a\xe6\xb5\x8b\xe8\xaf\x95" "b\xf0\x9f\x98\x86\xc2\xa9\"");
+
+	// invalid UTF-8
+	for (const std::string& testInput : std::vector<std::string>({
+		"\x80",             // unexpected continuation byte
+		"\xc0\xaf",         // overlong
+		"\xe0\x80\xaf",     // overlong
+		"\xed\xa0\x80",     // surrogate
+		"\xf4\x90\x80\x80", // > U+10FFFF
+		"abc\xe6\xb5",      // truncated
+		"\xe6\x41\x8b",     // not a continuation byte
+	}))
+	{
+		EXPECT_THROW(
+			DumpStr(Internal::Obj::String(testInput), cfg);,
+			SerializeValueError
+		);
+	}
+}
+
+GTEST_TEST(TestJsonWriter, StringWriterEscapePos)
+{
+	// special characters at every position of a string that spans
+	// several blocks
+	const std::vector<std::pair<std::string, std::string> > escEscaped = {
+		{ "\"", "\\\"" },
+		{ "\\", "\\\\" },
+		{ "/", "\\/" },
+		{ "\n", "\\n" },
+		{ "\x01", "\\u0001" },
+		{ "\xe6\xb5\x8b", "\\u6D4B" },
+	};
+	const std::vector<std::pair<std::string, std::string> > escRaw = {
+		{ "\"", "\\\"" },
+		{ "\\", "\\\\" },
+		{ "/", "/" },
+		{ "\n", "\\n" },
+		{ "\x01", "\\u0001" },
+		{ "\xe6\xb5\x8b", "\xe6\xb5\x8b" },
+	};
+
+	WriterConfig rawCfg;
+	rawCfg.m_escapeUnicode = false;
+
+	for (size_t pos = 0; pos < 20; ++pos)
+	{
+		for (const auto& esc : escEscaped)
+		{
+			std::string testInput(20, 'a');
+			testInput.insert(pos, esc.first);
+			std::string expRes(20, 'a');
+			expRes.insert(pos, esc.second);
+
+			EXPECT_EQ(DumpStr(Internal::Obj::String(testInput)),
+				"\"" + expRes + "\"");
+		}
+		for (const auto& esc : escRaw)
+		{
+			std::string testInput(20, 'a');
+			testInput.insert(pos, esc.first);
+			std::string expRes(20, 'a');
+			expRes.insert(pos, esc.second);
+
+			EXPECT_EQ(DumpStr(Internal::Obj::String(testInput), rawCfg),
+				"\"" + expRes + "\"");
+		}
+	}
+}
+
+GTEST_TEST(TestJsonWriter, OutputSink)
+{
+	// small writes across the buffer boundary, and a write larger than the
+	// buffer
+	{
+		std::string res;
+		StringOutputSink sink(res);
+
+		std::string expRes;
+		for (size_t i = 0; i < OutputSink::sk_bufSize + 10; ++i)
+		{
+			sink.Put(static_cast<char>('a' + (i % 26)));
+			expRes.push_back(static_cast<char>('a' + (i % 26)));
+		}
+		sink.Write("012", 3);
+		expRes += "012";
+
+		std::string largeStr(OutputSink::sk_bufSize * 2 + 1, 'x');
+		sink.Write(largeStr.data(), largeStr.size());
+		expRes += largeStr;
+
+		sink.Flush();
+		EXPECT_EQ(res, expRes);
+
+		// nothing is left in the buffer
+		sink.Flush();
+		EXPECT_EQ(res, expRes);
+	}
+
+	// writers through the sink iterator
+	{
+		std::string res;
+		StringOutputSink sink(res);
+
+		JsonWriterString::Write(
+			OutputSinkIt(sink),
+			Internal::Obj::String("\" \\ / \b \f \n \r \t \xe6\xb5\x8b"),
+			WriterConfig(), WriterStates());
+		JsonWriterNull::Write(OutputSinkIt(sink),
+			WriterConfig(), WriterStates());
+		EXPECT_EQ(res, "");
+
+		sink.Flush();
+		EXPECT_EQ(res,
+			"\"\\\" \\\\ \\/ \\b \\f \\n \\r \\t \\u6D4B\"null");
+	}
+
+	// DumpStr with a long string
+	{
+		std::string longStr(OutputSink::sk_bufSize * 3, 'a');
+		longStr[100] = '\n';
+		longStr[OutputSink::sk_bufSize] = '/';
+
+		std::string expRes = "\"" + longStr + "\"";
+		expRes.replace(OutputSink::sk_bufSize + 1, 1, "\\/");
+		expRes.replace(100 + 1, 1, "\\n");
+
+		EXPECT_EQ(DumpStr(Internal::Obj::String(longStr)), expRes);
+	}
+}
+
+GTEST_TEST(TestJsonWriter, DumpToStreamAndFd)
+{
+	std::string longStr(OutputSink::sk_bufSize * 3 + 5, 'a');
+	auto inputObj = LoadStr(
+		"[\"" + longStr + "\", {\"a\":[1, 2.5, null, true]}, \"" +
+		longStr + "\"]");
+
+	WriterConfig cfg;
+	cfg.m_indent = "\t";
+	const std::string expRes = DumpStr(inputObj, cfg);
+
+	{
+		std::ostringstream oss;
+		DumpToStream(oss, inputObj, cfg);
+		EXPECT_EQ(oss.str(), expRes);
+	}
+
+	{
+		std::FILE* file = std::tmpfile();
+		ASSERT_NE(file, nullptr);
+		DumpToFile(file, inputObj, cfg);
+
+		std::string res(expRes.size() + 1, '\0');
+		std::rewind(file);
+		res.resize(std::fread(&res[0], 1, res.size(), file));
+		std::fclose(file);
+
+		EXPECT_EQ(res, expRes);
+	}
+
+#if defined(__unix__) || defined(__APPLE__)
+	{
+		std::FILE* file = std::tmpfile();
+		ASSERT_NE(file, nullptr);
+		DumpToFd(fileno(file), inputObj, cfg);
+
+		std::string res(expRes.size() + 1, '\0');
+		std::rewind(file);
+		res.resize(std::fread(&res[0], 1, res.size(), file));
+		std::fclose(file);
+
+		EXPECT_EQ(res, expRes);
+	}
+
+	EXPECT_THROW(
+		DumpToFd(-1, inputObj, cfg);,
+		Exception
+	);
+#endif // defined(__unix__) || defined(__APPLE__)
+}
+
+GTEST_TEST(TestJsonWriter, StreamWriter)
+{
+	const std::string expInput =
+		"{\"a\":[1, -2, 4294967296, 2.5, \"s\\n\", true, null, [], {}],"
+		"\"b\":{\"c\":[[0.0]]}}";
+	auto expObj = LoadStr(expInput);
+
+	auto writeDoc = [](JsonStreamWriter& writer)
+	{
+		writer.StartObject();
+		writer.Key("a");
+		writer.StartArray();
+		writer.Value(1);
+		writer.Value(static_cast<int64_t>(-2));
+		writer.Value(static_cast<uint64_t>(4294967296ULL));
+		writer.Value(2.5);
+		writer.Value("s\n");
+		writer.Value(true);
+		writer.Null();
+		writer.StartArray();
+		writer.EndArray();
+		writer.StartObject();
+		writer.EndObject();
+		writer.EndArray();
+		writer.Key(std::string("b"));
+		writer.StartObject();
+		writer.Key("c", 1);
+		writer.StartArray();
+		writer.StartArray();
+		writer.Value(0.0f);
+		writer.EndArray();
+		writer.EndArray();
+		writer.EndObject();
+		writer.EndObject();
+	};
+
+	for (const std::string& indent : std::vector<std::string>({ "", "\t" }))
+	{
+		WriterConfig cfg;
+		cfg.m_indent = indent;
+
+		std::string res;
+		StringOutputSink sink(res);
+		JsonStreamWriter writer(sink, cfg);
+
+		EXPECT_FALSE(writer.IsComplete());
+		writeDoc(writer);
+		EXPECT_TRUE(writer.IsComplete());
+		sink.Flush();
+
+		EXPECT_EQ(res, DumpStr(expObj, cfg));
+	}
+
+	std::string res;
+	StringOutputSink sink(res);
+	{
+		JsonStreamWriter writer(sink);
+		writer.StartArray();
+		writer.Value(std::numeric_limits<uint64_t>::max());
+		writer.Value(std::numeric_limits<int64_t>::min());
+		writer.EndArray();
+		sink.Flush();
+		EXPECT_EQ(res, "[18446744073709551615,-9223372036854775808]");
+	}
+
+	// invalid structures
+	{
+		JsonStreamWriter writer(sink);
+		writer.Value(1);
+		EXPECT_THROW(writer.Value(2);, SerializeValueError);
+		EXPECT_THROW(writer.EndArray();, SerializeValueError);
+	}
+	{
+		JsonStreamWriter writer(sink);
+		EXPECT_THROW(writer.Key("a");, SerializeValueError);
+		writer.StartObject();
+		EXPECT_THROW(writer.Value(1);, SerializeValueError);
+		EXPECT_THROW(writer.EndArray();, SerializeValueError);
+		writer.Key("a");
+		EXPECT_THROW(writer.Key("b");, SerializeValueError);
+		EXPECT_THROW(writer.EndObject();, SerializeValueError);
+		EXPECT_THROW(writer.Value(std::nan(""));, SerializeValueError);
+		writer.StartArray();
+		EXPECT_THROW(writer.Key("b");, SerializeValueError);
+		EXPECT_THROW(writer.EndObject();, SerializeValueError);
+		EXPECT_FALSE(writer.IsComplete());
+	}
+}
+
 GTEST_TEST(TestJsonWriter, UnserializableType)
 {
 	{
@@ -272,6 +760,69 @@ GTEST_TEST(TestJsonWriter, ListWriter)
 	}
 }
 
+GTEST_TEST(TestJsonWriter, PrettyDeepNesting)
+{
+	auto inputObj = LoadStr("[[[[1, {\"a\":[{}]}]]], [], 2]");
+
+	WriterConfig cfg;
+	cfg.m_indent = "  ";
+	cfg.m_lineEnd = "\r\n";
+
+	EXPECT_EQ(DumpStr(inputObj, cfg),
+		"[\r\n"
+		"  [\r\n"
+		"    [\r\n"
+		"      [\r\n"
+		"        1,\r\n"
+		"        {\r\n"
+		"          \"a\" : [\r\n"
+		"            {}\r\n"
+		"          ]\r\n"
+		"        }\r\n"
+		"      ]\r\n"
+		"    ]\r\n"
+		"  ],\r\n"
+		"  [],\r\n"
+		"  2\r\n"
+		"]");
+
+	// start from a nested level
+	std::string res;
+	WriterStates st;
+	st.m_nestLevel = 2;
+	JsonWriterObject::Write(
+		std::back_inserter(res), LoadStr("[1,[]]"), cfg, st);
+	EXPECT_EQ(res,
+		"[\r\n"
+		"      1,\r\n"
+		"      []\r\n"
+		"    ]");
+}
+
+GTEST_TEST(TestJsonWriter, CompactWriter)
+{
+	auto inputObj = LoadStr(sk_listTestInput_01);
+
+	WriterConfig cfg;
+	cfg.m_indent = "\t";
+
+	// indentation settings are ignored by the compact writer
+	EXPECT_EQ(
+		(DumpStr<Internal::Obj::Object, JsonWriterCompactObject>(inputObj, cfg)),
+		sk_listTestInput_02);
+	EXPECT_EQ(
+		(DumpStr<Internal::Obj::Object, JsonWriterCompactObject>(inputObj)),
+		DumpStr(inputObj));
+
+	inputObj = LoadStr(sk_dictTestInput_01_a);
+	std::string res =
+		DumpStr<Internal::Obj::Object, JsonWriterCompactObject>(inputObj, cfg);
+	EXPECT_TRUE((res == sk_dictTestInput_02_a) ||
+				(res == sk_dictTestInput_02_b) ||
+				(res == sk_dictTestInput_02_c) ||
+				(res == sk_dictTestInput_02_d));
+}
+
 GTEST_TEST(TestJsonWriter, DictWriter)
 {
 	{
@@ -300,6 +851,275 @@ GTEST_TEST(TestJsonWriter, DictWriter)
 	}
 }
 
+GTEST_TEST(TestJsonWriter, NdJsonWriter)
+{
+	std::vector<Internal::Obj::Object> records = {
+		Internal::Obj::Dict({
+			{ Internal::Obj::String("msg"), Internal::Obj::String("a\nb") },
+		}),
+		Internal::Obj::List({
+			Internal::Obj::Int64(1),
+			Internal::Obj::List({ Internal::Obj::Null() }),
+		}),
+		Internal::Obj::String("end"),
+	};
+
+	WriterConfig prettyCfg;
+	prettyCfg.m_indent = "\t";
+
+	const std::string expRes =
+		"{\"msg\":\"a\\nb\"}\n"
+		"[1,[null]]\n"
+		"\"end\"\n";
+	EXPECT_EQ(DumpNdJsonStr(records.begin(), records.end()), expRes);
+	EXPECT_EQ(
+		DumpNdJsonStr(records.begin(), records.end(), prettyCfg), expRes);
+	EXPECT_EQ(DumpNdJsonStr(records.end(), records.end()), "");
+
+	// records written one by one share the sink
+	std::string res;
+	StringOutputSink sink(res);
+	NdJsonWriter writer(sink, prettyCfg);
+	for (const auto& record : records)
+	{
+		writer.Write(record);
+	}
+	EXPECT_EQ(writer.GetCount(), records.size());
+	EXPECT_EQ(
+		DumpNdJsonToSink(sink, records.begin(), records.begin() + 1), 1);
+	sink.Flush();
+	EXPECT_EQ(res, expRes + "{\"msg\":\"a\\nb\"}\n");
+}
+
+GTEST_TEST(TestJsonWriter, BytesWriter)
+{
+	WriterConfig base64Cfg;
+	base64Cfg.m_bytesEncoding = BytesEncoding::Base64;
+	WriterConfig hexCfg;
+	hexCfg.m_bytesEncoding = BytesEncoding::Hex;
+
+	// RFC 4648, Section 10
+	auto toBytes = [](const std::string& s)
+	{
+		return Internal::Obj::Bytes(std::vector<uint8_t>(s.begin(), s.end()));
+	};
+	EXPECT_EQ(DumpStr(toBytes(""), base64Cfg), "\"\"");
+	EXPECT_EQ(DumpStr(toBytes("f"), base64Cfg), "\"Zg==\"");
+	EXPECT_EQ(DumpStr(toBytes("fo"), base64Cfg), "\"Zm8=\"");
+	EXPECT_EQ(DumpStr(toBytes("foo"), base64Cfg), "\"Zm9v\"");
+	EXPECT_EQ(DumpStr(toBytes("foob"), base64Cfg), "\"Zm9vYg==\"");
+	EXPECT_EQ(DumpStr(toBytes("fooba"), base64Cfg), "\"Zm9vYmE=\"");
+	EXPECT_EQ(DumpStr(toBytes("foobar"), base64Cfg), "\"Zm9vYmFy\"");
+	EXPECT_EQ(DumpStr(toBytes(std::string("\x00\xFF\xA1", 3)), hexCfg),
+		"\"00ffa1\"");
+
+	EXPECT_THROW(DumpStr(toBytes("f"));, SerializeTypeError);
+
+	// in containers, and as keys
+	Internal::Obj::Dict dict({
+		{ toBytes("key"), Internal::Obj::List({ toBytes("\xFB\xFF") }) },
+	});
+	EXPECT_EQ(DumpStr(dict, base64Cfg), "{\"a2V5\":[\"+/8=\"]}");
+	EXPECT_EQ(DumpStr(dict, hexCfg), "{\"6b6579\":[\"fbff\"]}");
+
+	// round trip, across multiple blocks
+	std::mt19937 rng(48);
+	BytesParser base64Parser;
+	BytesParser hexParser(BytesEncoding::Hex);
+	for (size_t len : { 1, 2, 3, 191, 192, 193, 1000 })
+	{
+		std::vector<uint8_t> data(len);
+		for (auto& b : data)
+		{
+			b = static_cast<uint8_t>(rng());
+		}
+		Internal::Obj::Bytes bytes(data);
+
+		auto res = base64Parser.ParseTillEnd(DumpStr(bytes, base64Cfg));
+		EXPECT_EQ(std::vector<uint8_t>(res.data(), res.data() + res.size()),
+			data);
+		EXPECT_EQ(MeasureJson(bytes, base64Cfg), ((len + 2) / 3) * 4 + 2);
+
+		res = hexParser.ParseTillEnd(DumpStr(bytes, hexCfg));
+		EXPECT_EQ(std::vector<uint8_t>(res.data(), res.data() + res.size()),
+			data);
+		EXPECT_EQ(MeasureJson(bytes, hexCfg), len * 2 + 2);
+	}
+}
+
+GTEST_TEST(TestJsonWriter, TypedContainerWriter)
+{
+	using Int64List = Internal::Obj::ListT<Internal::Obj::Int64>;
+	using DoubleList = Internal::Obj::ListT<Internal::Obj::Double>;
+	using StringList = Internal::Obj::ListT<Internal::Obj::String>;
+	using Int64ListList = Internal::Obj::ListT<Int64List>;
+	using Int64Dict =
+		Internal::Obj::DictT<Internal::Obj::HashableObject, Internal::Obj::Int64>;
+
+	static_assert(std::is_same<
+			FindObjWriter<Int64List>::type,
+			JsonWriterTypedListT<
+				Internal::Obj::Int64,
+				JsonWriterNumValT<Internal::Obj::Int64> >
+		>::value, "Typed list writer is expected");
+	static_assert(std::is_same<
+			FindObjWriter<Int64Dict>::type,
+			JsonWriterTypedDictT<
+				Internal::Obj::HashableObject,
+				Internal::Obj::Int64,
+				JsonWriterKey,
+				JsonWriterNumValT<Internal::Obj::Int64> >
+		>::value, "Typed dict writer is expected");
+	// the typed traits walk the concrete storage of the container
+	static_assert(std::is_same<
+			TypedListTraits<ToStringType, Internal::Obj::Int64>::ListBase,
+			Int64List
+		>::value, "Typed list traits should take the concrete list");
+
+	WriterConfig prettyCfg;
+	prettyCfg.m_indent = "\t";
+
+	for (const WriterConfig& cfg : { WriterConfig(), prettyCfg })
+	{
+		Int64List ints({
+			Internal::Obj::Int64(0),
+			Internal::Obj::Int64(-9223372036854775807LL - 1),
+			Internal::Obj::Int64(42),
+		});
+		Internal::Obj::List intsObj({
+			Internal::Obj::Int64(0),
+			Internal::Obj::Int64(-9223372036854775807LL - 1),
+			Internal::Obj::Int64(42),
+		});
+		EXPECT_EQ(DumpStr(ints, cfg), DumpStr(intsObj, cfg));
+		EXPECT_EQ(MeasureJson(ints, cfg), DumpStr(intsObj, cfg).size());
+
+		DoubleList reals({
+			Internal::Obj::Double(0.1),
+			Internal::Obj::Double(-1.5e300),
+		});
+		Internal::Obj::List realsObj({
+			Internal::Obj::Double(0.1),
+			Internal::Obj::Double(-1.5e300),
+		});
+		EXPECT_EQ(DumpStr(reals, cfg), DumpStr(realsObj, cfg));
+
+		StringList strs({
+			Internal::Obj::String("a"),
+			Internal::Obj::String("\"\n"),
+		});
+		Internal::Obj::List strsObj({
+			Internal::Obj::String("a"),
+			Internal::Obj::String("\"\n"),
+		});
+		EXPECT_EQ(DumpStr(strs, cfg), DumpStr(strsObj, cfg));
+
+		Int64ListList nested({ ints, Int64List(), ints });
+		Internal::Obj::List nestedObj({
+			intsObj, Internal::Obj::List(), intsObj });
+		EXPECT_EQ(DumpStr(nested, cfg), DumpStr(nestedObj, cfg));
+
+		Int64Dict dict({
+			{ Internal::Obj::String("key"), Internal::Obj::Int64(-7) },
+		});
+		Internal::Obj::Dict dictObj({
+			{ Internal::Obj::String("key"), Internal::Obj::Int64(-7) },
+		});
+		EXPECT_EQ(DumpStr(dict, cfg), DumpStr(dictObj, cfg));
+	}
+
+	EXPECT_EQ(DumpStr(Int64List()), "[]");
+	EXPECT_EQ(DumpStr(Internal::Obj::Bool(true)), "true");
+	EXPECT_EQ(DumpStr(Internal::Obj::Bool(false)), "false");
+	EXPECT_EQ(DumpStr(Internal::Obj::Int64(-12)), "-12");
+	EXPECT_EQ(DumpStr(Internal::Obj::Double(2.5)), "2.5");
+}
+
+GTEST_TEST(TestJsonWriter, MeasureJson)
+{
+	{
+		auto inputObj = LoadStr(sk_dictTestInput_01_a);
+
+		WriterConfig cfg;
+		cfg.m_indent = "\t";
+		EXPECT_EQ(MeasureJson(inputObj, cfg), DumpStr(inputObj, cfg).size());
+		EXPECT_EQ(MeasureJson(inputObj, cfg), sizeof(sk_dictTestInput_01_a) - 1);
+
+		EXPECT_EQ(MeasureJson(inputObj), DumpStr(inputObj).size());
+		EXPECT_EQ(MeasureJson(inputObj), sizeof(sk_dictTestInput_02_a) - 1);
+	}
+
+	{
+		auto inputObj = LoadStr(sk_listTestInput_01);
+
+		WriterConfig cfg;
+		cfg.m_indent = "    ";
+		cfg.m_lineEnd = "\r\n";
+		EXPECT_EQ(MeasureJson(inputObj, cfg), DumpStr(inputObj, cfg).size());
+	}
+
+	{
+		Internal::Obj::String testObj("\" \\ / \b \f \n \r \t \xf0\x9f\x98\x86");
+		EXPECT_EQ(MeasureJson(testObj), 38);
+		EXPECT_EQ(MeasureJson(testObj), DumpStr(testObj).size());
+	}
+
+	EXPECT_EQ(MeasureJson(Decimal(true, 5, -3)), 6);
+
+	{
+		auto inputObj = LoadStr(sk_dictTestInput_01_a);
+
+		WriterConfig cfg;
+		cfg.m_indent = "\t";
+		const std::string res = DumpStrExact(inputObj, cfg);
+		EXPECT_EQ(res, DumpStr(inputObj, cfg));
+		// no growth slack, beyond the rounding of the allocator
+		EXPECT_LT(res.capacity(), res.size() + 16);
+	}
+}
+
+GTEST_TEST(TestJsonWriter, DumpToBuffer)
+{
+	auto inputObj = LoadStr(sk_dictTestInput_01_a);
+
+	WriterConfig prettyCfg;
+	prettyCfg.m_indent = "\t";
+
+	for (const WriterConfig& cfg : { WriterConfig(), prettyCfg })
+	{
+		const std::string expRes = DumpStr(inputObj, cfg);
+		std::vector<char> buf(expRes.size() + 8, '#');
+
+		// fits
+		auto res = DumpToBuffer(buf.data(), buf.size(), inputObj, cfg);
+		EXPECT_TRUE(res.first);
+		EXPECT_EQ(res.second, expRes.size());
+		EXPECT_EQ(std::string(buf.data(), res.second), expRes);
+		EXPECT_EQ(buf[expRes.size()], '#');
+
+		// exactly fits
+		std::fill(buf.begin(), buf.end(), '#');
+		res = DumpToBuffer(buf.data(), expRes.size(), inputObj, cfg);
+		EXPECT_TRUE(res.first);
+		EXPECT_EQ(res.second, expRes.size());
+		EXPECT_EQ(std::string(buf.data(), res.second), expRes);
+		EXPECT_EQ(buf[expRes.size()], '#');
+
+		// overflows
+		std::fill(buf.begin(), buf.end(), '#');
+		res = DumpToBuffer(buf.data(), 10, inputObj, cfg);
+		EXPECT_FALSE(res.first);
+		EXPECT_EQ(res.second, expRes.size());
+		EXPECT_EQ(res.second, MeasureJson(inputObj, cfg));
+		EXPECT_EQ(std::string(buf.data(), 10), expRes.substr(0, 10));
+		EXPECT_EQ(buf[10], '#');
+
+		res = DumpToBuffer(nullptr, 0, inputObj, cfg);
+		EXPECT_FALSE(res.first);
+		EXPECT_EQ(res.second, expRes.size());
+	}
+}
+
 GTEST_TEST(TestJsonWriter, ObjectWriter)
 {
 	// null key
@@ -362,3 +1182,313 @@ GTEST_TEST(TestJsonWriter, ObjectWriter)
 		EXPECT_EQ(res, "{\"string\":\"string\"}");
 	}
 }
+
+GTEST_TEST(TestJsonWriter, EcmaNumFormatter)
+{
+	char buf[Internal::sk_ecmaFormatBufSize];
+
+	// samples from RFC 8785, Appendix B
+	const std::vector<std::pair<uint64_t, std::string> > samples = {
+		{ 0x0000000000000000ULL, "0" },
+		{ 0x8000000000000000ULL, "0" },
+		{ 0x0000000000000001ULL, "5e-324" },
+		{ 0x8000000000000001ULL, "-5e-324" },
+		{ 0x7fefffffffffffffULL, "1.7976931348623157e+308" },
+		{ 0xffefffffffffffffULL, "-1.7976931348623157e+308" },
+		{ 0x4340000000000000ULL, "9007199254740992" },
+		{ 0xc340000000000000ULL, "-9007199254740992" },
+		{ 0x4430000000000000ULL, "295147905179352830000" },
+		{ 0x44b52d02c7e14af5ULL, "9.999999999999997e+22" },
+		{ 0x44b52d02c7e14af6ULL, "1e+23" },
+		{ 0x44b52d02c7e14af7ULL, "1.0000000000000001e+23" },
+		{ 0x444b1ae4d6e2ef4eULL, "999999999999999700000" },
+		{ 0x444b1ae4d6e2ef4fULL, "999999999999999900000" },
+		{ 0x444b1ae4d6e2ef50ULL, "1e+21" },
+		{ 0x3eb0c6f7a0b5ed8cULL, "9.999999999999997e-7" },
+		{ 0x3eb0c6f7a0b5ed8dULL, "0.000001" },
+		{ 0x41b3de4355555553ULL, "333333333.3333332" },
+		{ 0x41b3de4355555554ULL, "333333333.33333325" },
+		{ 0x41b3de4355555555ULL, "333333333.3333333" },
+		{ 0x41b3de4355555556ULL, "333333333.3333334" },
+		{ 0x41b3de4355555557ULL, "333333333.33333343" },
+		{ 0xbecbf647612f3696ULL, "-0.0000033333333333333333" },
+		{ 0x43143ff3c1cb0959ULL, "1424953923781206.2" },
+	};
+	for (const auto& sample : samples)
+	{
+		double val = 0.0;
+		std::memcpy(&val, &sample.first, sizeof(val));
+
+		char* end = Internal::FormatEcmaNumber(buf, val);
+		EXPECT_EQ(std::string(buf, end), sample.second);
+	}
+
+	// the digits must be the shortest, and the closest to the value,
+	// which is what "%.*e" gives at the shortest precision that round-trips
+	std::mt19937_64 rng(54321);
+	for (size_t i = 0; i < 100000; ++i)
+	{
+		uint64_t bits = rng();
+		double val = 0.0;
+		std::memcpy(&val, &bits, sizeof(val));
+		if (!std::isfinite(val) || val == 0)
+		{
+			continue;
+		}
+
+		char* end = Internal::FormatEcmaNumber(buf, val);
+		std::string str(buf, end);
+		EXPECT_EQ(strtod(str.c_str(), nullptr), val) << str;
+
+		std::string digits;
+		for (char ch : str.substr(0, str.find('e')))
+		{
+			if ('0' <= ch && ch <= '9')
+			{
+				digits.push_back(ch);
+			}
+		}
+		digits.erase(0, digits.find_first_not_of('0'));
+		digits.erase(digits.find_last_not_of('0') + 1);
+
+		char ref[32];
+		for (int prec = 1; prec <= 17; ++prec)
+		{
+			std::snprintf(ref, sizeof(ref), "%.*e", prec - 1, val);
+			if (strtod(ref, nullptr) == val)
+			{
+				break;
+			}
+		}
+		std::string refDigits;
+		for (const char* ptr = ref; *ptr != 'e'; ++ptr)
+		{
+			if ('0' <= *ptr && *ptr <= '9')
+			{
+				refDigits.push_back(*ptr);
+			}
+		}
+		refDigits.erase(refDigits.find_last_not_of('0') + 1);
+
+		EXPECT_EQ(digits, refDigits) << str;
+	}
+}
+
+GTEST_TEST(TestJsonWriter, CanonicalWriter)
+{
+	// example from RFC 8785, Section 3.2.2
+	{
+		auto obj = LoadStr(
+			"{\n"
+			"  \"numbers\": [333333333.33333329, 1E30, 4.50,\n"
+			"              2e-3, 0.000000000000000000000000001],\n"
+			"  \"string\": \"\\u20ac$\\u000F\\u000aA'\\u0042\\u0022\\u005c\\\\\\\"\\/\",\n"
+			"  \"literals\": [null, true, false]\n"
+			"}");
+		EXPECT_EQ(DumpCanonicalStr(obj),
+			"{\"literals\":[null,true,false],"
+			"\"numbers\":[333333333.3333333,1e+30,4.5,0.002,1e-27],"
+			"\"string\":\"\xE2\x82\xAC$\\u000f\\nA'B\\\"\\\\\\\\\\\"/\"}");
+	}
+
+	// key order by UTF-16 code units, from RFC 8785, Section 3.2.3
+	{
+		auto obj = LoadStr(
+			"{\n"
+			"  \"\\u20ac\": \"Euro Sign\",\n"
+			"  \"\\r\": \"Carriage Return\",\n"
+			"  \"\\ufb33\": \"Hebrew Letter Dalet With Dagesh\",\n"
+			"  \"1\": \"One\",\n"
+			"  \"\\ud83d\\ude00\": \"Emoji: Grinning Face\",\n"
+			"  \"\\u0080\": \"Control\",\n"
+			"  \"\\u00f6\": \"Latin Small Letter O With Diaeresis\"\n"
+			"}");
+		EXPECT_EQ(DumpCanonicalStr(obj),
+			"{\"\\r\":\"Carriage Return\","
+			"\"1\":\"One\","
+			"\"\xC2\x80\":\"Control\","
+			"\"\xC3\xB6\":\"Latin Small Letter O With Diaeresis\","
+			"\"\xE2\x82\xAC\":\"Euro Sign\","
+			"\"\xF0\x9F\x98\x80\":\"Emoji: Grinning Face\","
+			"\"\xEF\xAC\xB3\":\"Hebrew Letter Dalet With Dagesh\"}");
+	}
+
+	// nested dicts share the sort buffer; prefix keys go first
+	{
+		auto obj = LoadStr(
+			"{\"b\":{\"z\":1,\"y\":{\"d\":[{\"c\":0,\"a\":1}],\"cc\":2}},"
+			"\"a\":-0.0,\"ab\":[],\"aa\":{}}");
+		EXPECT_EQ(DumpCanonicalStr(obj),
+			"{\"a\":0,\"aa\":{},\"ab\":[],"
+			"\"b\":{\"y\":{\"cc\":2,\"d\":[{\"a\":1,\"c\":0}]},\"z\":1}}");
+	}
+
+	// integers beyond 2^53 are written as doubles
+	{
+		Internal::Obj::Object obj = Internal::Obj::Int64(
+			std::numeric_limits<int64_t>::max());
+		EXPECT_EQ(DumpCanonicalStr(obj), "9223372036854776000");
+
+		obj = Internal::Obj::Int64(-9007199254740992LL);
+		EXPECT_EQ(DumpCanonicalStr(obj), "-9007199254740992");
+	}
+
+	// invalid values
+	{
+		Internal::Obj::Object obj = Internal::Obj::Dict({
+			{ Internal::Obj::Int64(1), Internal::Obj::Int64(1) }
+		});
+		EXPECT_THROW(DumpCanonicalStr(obj);, SerializeTypeError);
+
+		obj = Internal::Obj::Double(std::numeric_limits<double>::infinity());
+		EXPECT_THROW(DumpCanonicalStr(obj);, SerializeValueError);
+
+		obj = Internal::Obj::String("\xFF");
+		EXPECT_THROW(DumpCanonicalStr(obj);, SerializeValueError);
+	}
+}
+
+GTEST_TEST(TestJsonWriter, SerializeCache)
+{
+	Internal::Obj::List root({
+		Internal::Obj::String("head"),
+		Internal::Obj::List({
+			Internal::Obj::Int64(1),
+			Internal::Obj::List({
+				Internal::Obj::String("a"),
+				Internal::Obj::Null(),
+			}),
+		}),
+		Internal::Obj::Int64(2),
+	});
+	const void* subtree = &(root[1]);
+
+	WriterConfig prettyCfg;
+	prettyCfg.m_indent = "\t";
+
+	SerializeCache cache;
+	cache.Mark(subtree, 1);
+	EXPECT_TRUE(cache.IsMarked(subtree));
+	EXPECT_EQ(cache.GetGeneration(subtree), std::make_pair(true, uint64_t(1)));
+
+	// the bytes are stored by the first write, and copied by later ones
+	for (size_t i = 0; i < 2; ++i)
+	{
+		EXPECT_EQ(DumpStr(root, cache), DumpStr(root));
+		EXPECT_EQ(cache.GetSize(), DumpStr(root[1]).size());
+	}
+	EXPECT_EQ(DumpStr(root, cache, prettyCfg), DumpStr(root, prettyCfg));
+	EXPECT_EQ(
+		(DumpStr<Internal::Obj::List, JsonWriterCompactObject>(
+			root, cache, prettyCfg)),
+		DumpStr(root));
+	// a pretty one at a different nesting level is another variant
+	const size_t twoVariants = cache.GetSize();
+	EXPECT_EQ(DumpStr(root[1], cache, prettyCfg), DumpStr(root[1], prettyCfg));
+	EXPECT_GT(cache.GetSize(), twoVariants);
+
+	// the cached bytes are used until the subtree is marked again with
+	// a new generation
+	root[1] = Internal::Obj::List({ Internal::Obj::Int64(3) });
+	EXPECT_EQ(&(root[1]), subtree);
+	EXPECT_EQ(DumpStr(root, cache), "[\"head\",[1,[\"a\",null]],2]");
+	cache.Mark(subtree, 1);
+	EXPECT_EQ(DumpStr(root, cache), "[\"head\",[1,[\"a\",null]],2]");
+	cache.Mark(subtree, 2);
+	EXPECT_EQ(cache.GetSize(), 0);
+	EXPECT_EQ(DumpStr(root, cache), "[\"head\",[3],2]");
+	EXPECT_EQ(cache.GetSize(), 3);
+
+	cache.Invalidate(subtree);
+	EXPECT_FALSE(cache.IsMarked(subtree));
+	EXPECT_EQ(cache.GetSize(), 0);
+	EXPECT_EQ(DumpStr(root, cache), "[\"head\",[3],2]");
+	EXPECT_EQ(cache.GetSize(), 0);
+
+	// the least recently used variant is evicted
+	{
+		SerializeCache smallCache(4);
+		smallCache.Mark(subtree, 0);
+		smallCache.Mark(&(root[0]), 0);
+
+		// "\"head\"" is too large to be cached
+		EXPECT_EQ(DumpStr(root, smallCache), "[\"head\",[3],2]");
+		EXPECT_EQ(smallCache.GetSize(), 3);
+
+		// "\"h\"" and "[3]" evict each other
+		root[0] = Internal::Obj::String("h");
+		smallCache.Mark(&(root[0]), 1);
+		for (size_t i = 0; i < 2; ++i)
+		{
+			EXPECT_EQ(DumpStr(root, smallCache), "[\"h\",[3],2]");
+			EXPECT_EQ(smallCache.GetSize(), 3);
+		}
+
+		smallCache.Clear();
+		EXPECT_FALSE(smallCache.IsMarked(subtree));
+		EXPECT_EQ(smallCache.GetSize(), 0);
+	}
+}
+
+GTEST_TEST(TestJsonWriter, ParallelWriter)
+{
+	// a large top-level list, a large nested list, a large nested dict,
+	// mid-sized containers, and an envelope with only a few items
+	std::string input = "[";
+	for (size_t i = 0; i < 3000; ++i)
+	{
+		input += (i == 0 ? "" : ",");
+		input += "{\"id\":" + std::to_string(i) +
+			",\"name\":\"n\\u00e9" + std::to_string(i) + "\"" +
+			",\"tags\":[1,2.5,true,null,[],{}]}";
+	}
+	input += ",{\"big\":[";
+	for (size_t i = 0; i < 500; ++i)
+	{
+		input += (i == 0 ? "" : ",");
+		input += std::to_string(i);
+	}
+	input += "],\"map\":{";
+	for (size_t i = 0; i < 500; ++i)
+	{
+		input += (i == 0 ? "" : ",");
+		input += "\"k" + std::to_string(i) + "\":[" + std::to_string(i) + "]";
+	}
+	input += "}}]";
+
+	const auto obj = LoadStr(input);
+	const auto envelope = LoadStr("{\"data\":" + input + ",\"n\":1}");
+
+	WriterConfig prettyCfg;
+	prettyCfg.m_indent = "  ";
+	prettyCfg.m_lineEnd = "\r\n";
+
+	for (size_t numThreads : std::vector<size_t>({ 1, 2, 4, 0 }))
+	{
+		for (const WriterConfig& cfg :
+			std::vector<WriterConfig>({ WriterConfig(), prettyCfg }))
+		{
+			EXPECT_EQ(DumpStrParallel(obj, cfg, numThreads),
+				DumpStr(obj, cfg));
+			EXPECT_EQ(DumpStrParallel(envelope, cfg, numThreads),
+				DumpStr(envelope, cfg));
+
+			for (size_t minChunkSize : std::vector<size_t>({ 1, 16, 200 }))
+			{
+				std::string res;
+				JsonWriterParallel::Write(std::back_inserter(res), envelope,
+					cfg, WriterStates(), numThreads, minChunkSize);
+				EXPECT_EQ(res, DumpStr(envelope, cfg));
+			}
+
+			std::string res;
+			JsonWriterCompactParallel::Write(std::back_inserter(res), obj,
+				cfg, WriterStates(), numThreads, 16);
+			EXPECT_EQ(res, DumpStr(obj));
+		}
+	}
+
+	// small and non-container values
+	EXPECT_EQ(DumpStrParallel(LoadStr("[]"), prettyCfg, 4), "[]");
+	EXPECT_EQ(DumpStrParallel(LoadStr("\"a\""), prettyCfg, 4), "\"a\"");
+}
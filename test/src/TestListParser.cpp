@@ -3,6 +3,11 @@
 // license that can be found in the LICENSE file or at
 // https://opensource.org/licenses/MIT.
 
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <SimpleJson/SimpleJson.hpp>
@@ -186,3 +191,223 @@ GTEST_TEST(TestListParser, ParseError)
 		);
 	}
 }
+
+GTEST_TEST(TestListParser, NumArrayParseCorrect)
+{
+	{
+		Int64ArrayParser parser;
+
+		std::string testInput =
+			" \t [ 0 , -1 ,1700000000123456789,\r\n 42 ]   ";
+		std::vector<int64_t> res;
+		std::vector<int64_t> exp = { 0, -1, 1700000000123456789LL, 42 };
+
+		EXPECT_NO_THROW(
+			res = parser.Parse(testInput);
+		);
+		EXPECT_EQ(res, exp);
+		EXPECT_NO_THROW(
+			res = parser.ParseTillEnd(testInput);
+		);
+		EXPECT_EQ(res, exp);
+	}
+	{
+		DoubleArrayParser parser;
+
+		std::string testInput =
+			" \t [ -65.613616999999977, 43.420273000000009, 0, 1e2 ]   ";
+		std::vector<double> res;
+		std::vector<double> exp =
+			{ -65.613616999999977, 43.420273000000009, 0.0, 100.0 };
+
+		EXPECT_NO_THROW(
+			res = parser.Parse(testInput);
+		);
+		EXPECT_EQ(res, exp);
+		EXPECT_NO_THROW(
+			res = parser.ParseTillEnd(testInput);
+		);
+		EXPECT_EQ(res, exp);
+	}
+	{
+		DoubleArrayParser parser;
+
+		std::string testInput = " \t [ ]   ";
+		std::vector<double> res = { 1.0 };
+
+		EXPECT_NO_THROW(
+			res = parser.ParseTillEnd(testInput);
+		);
+		EXPECT_EQ(res.size(), 0);
+	}
+	// nested (e.g., coordinates in GeoJSON)
+	{
+		ListParserImpl<
+			std::string,
+			DoubleArrayParser,
+			std::vector<std::vector<double> > > parser;
+
+		std::string testInput = "[[-65.6,43.4],[-65.7,43.5]]";
+		std::vector<std::vector<double> > res;
+		std::vector<std::vector<double> > exp =
+			{ { -65.6, 43.4 }, { -65.7, 43.5 } };
+
+		EXPECT_NO_THROW(
+			res = parser.ParseTillEnd(testInput);
+		);
+		EXPECT_EQ(res, exp);
+	}
+}
+
+GTEST_TEST(TestListParser, NumArrayParseError)
+{
+	{
+		Int64ArrayParser parser;
+
+		std::string testInput = " \t [ 1, 2.5 ]   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	{
+		DoubleArrayParser parser;
+
+		std::string testInput = " \t [ 1.0, null ]   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	{
+		DoubleArrayParser parser;
+
+		std::string testInput = " \t [ 1.0, 2.0, ]   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	{
+		DoubleArrayParser parser;
+
+		std::string testInput = " \t [ 1.0, 2.0   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	{
+		DoubleArrayParser parser;
+
+		std::string testInput = " \t { 1.0, 2.0 }   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	// out of range
+	{
+		NumArrayParserT<int32_t> parser;
+
+		EXPECT_EQ(parser.ParseTillEnd("[2147483647, -2147483648, -0]"),
+			std::vector<int32_t>({ 2147483647, -2147483647 - 1, 0 }));
+		EXPECT_THROW(parser.ParseTillEnd("[2147483648]");, ParseError);
+		EXPECT_THROW(parser.ParseTillEnd("[-2147483649]");, ParseError);
+	}
+	{
+		NumArrayParserT<uint8_t> parser;
+
+		EXPECT_EQ(parser.ParseTillEnd("[0, 255, -0]"),
+			std::vector<uint8_t>({ 0, 255, 0 }));
+		EXPECT_THROW(parser.ParseTillEnd("[256]");, ParseError);
+		EXPECT_THROW(parser.ParseTillEnd("[-1]");, ParseError);
+	}
+	{
+		NumArrayParserT<uint64_t> parser;
+
+		EXPECT_EQ(parser.ParseTillEnd(
+				"[9223372036854775808, 18446744073709551615]"),
+			std::vector<uint64_t>({
+				9223372036854775808ULL, 18446744073709551615ULL }));
+		EXPECT_THROW(parser.ParseTillEnd("[18446744073709551616]");,
+			ParseError);
+		EXPECT_THROW(parser.ParseTillEnd("[100000000000000000000]");,
+			ParseError);
+	}
+	{
+		Int64ArrayParser parser;
+
+		EXPECT_EQ(parser.ParseTillEnd(
+				"[9223372036854775807, -9223372036854775808]"),
+			std::vector<int64_t>({
+				9223372036854775807LL, -9223372036854775807LL - 1 }));
+		EXPECT_THROW(parser.ParseTillEnd("[9223372036854775808]");,
+			ParseError);
+		EXPECT_THROW(parser.ParseTillEnd("[-9223372036854775809]");,
+			ParseError);
+	}
+	{
+		NumArrayParserT<float> parser;
+
+		EXPECT_EQ(parser.ParseTillEnd("[1.5, -2]"),
+			std::vector<float>({ 1.5f, -2.0f }));
+		EXPECT_THROW(parser.ParseTillEnd("[1e39]");, ParseError);
+		EXPECT_THROW(parser.ParseTillEnd("[-1e39]");, ParseError);
+	}
+}
+
+GTEST_TEST(TestListParser, ParseInto)
+{
+	using namespace Internal::Obj;
+
+	ListParserT<StringParser> parser;
+	ListT<String> res;
+
+	parser.ParseTillEndInto(" [ \"abcdefghijklmnopqrstuvwxyz\", \"b\" ] ", res);
+	EXPECT_EQ(res, ListT<String>({
+		String("abcdefghijklmnopqrstuvwxyz"), String("b") }));
+
+	// existing items are reused
+	const char* firstData = res[0].data();
+	const size_t listCap = res.capacity();
+	parser.ParseTillEndInto("[\"0123456789012345678901234\"]", res);
+	EXPECT_EQ(res, ListT<String>({ String("0123456789012345678901234") }));
+	EXPECT_EQ(res[0].data(), firstData);
+	EXPECT_EQ(res.capacity(), listCap);
+
+	// grown
+	parser.ParseInto("[\"x\", \"y\", \"z\"]", res);
+	EXPECT_EQ(res, ListT<String>({ String("x"), String("y"), String("z") }));
+
+	parser.ParseInto("[]", res);
+	EXPECT_EQ(res, ListT<String>());
+
+	EXPECT_THROW(parser.ParseTillEndInto("[\"x\"] 1", res);, ParseError);
+
+	// lists of lists
+	ListParserT<ListParserT<IntegerParser> > nestedParser;
+	ListT<ListT<Int64> > nested;
+	nestedParser.ParseInto("[[1, 2, 3], [4]]", nested);
+	nestedParser.ParseInto("[[5], [6, 7]]", nested);
+	EXPECT_EQ(nested, ListT<ListT<Int64> >({
+		ListT<Int64>({ Int64(5) }), ListT<Int64>({ Int64(6), Int64(7) }) }));
+
+	// number arrays
+	Int64ArrayParser arrParser;
+	std::vector<int64_t> arr;
+	arrParser.ParseInto("[1, 2, 3, 4]", arr);
+	const int64_t* arrData = arr.data();
+	arrParser.ParseInto("[5, 6]", arr);
+	EXPECT_EQ(arr, std::vector<int64_t>({ 5, 6 }));
+	EXPECT_EQ(arr.data(), arrData);
+
+	// lists of generic objects
+	ListParserT<GenericObjectParser> objParser;
+	List objList;
+	objParser.ParseInto("[\"abcdefghijklmnopqrstuvwxyz\", [1]]", objList);
+	const char* objData = objList[0].AsString().data();
+	objParser.ParseInto("[\"a\", 1]", objList);
+	EXPECT_EQ(objList, List({ String("a"), Int64(1) }));
+	EXPECT_EQ(objList[0].AsString().data(), objData);
+}
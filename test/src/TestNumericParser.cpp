@@ -211,6 +211,105 @@ GTEST_TEST(TestRealNumParser, InternalParserIncorrect)
 	}
 }
 
+GTEST_TEST(TestRealNumParser, InternalEightDigits)
+{
+	{
+		std::string testInput = "12345678";
+		auto val = Internal::LoadEightChars(testInput.data());
+		EXPECT_TRUE(Internal::IsEightDigits(val));
+		EXPECT_EQ(Internal::EightDigitsToUInt(val), 12345678U);
+	}
+	{
+		std::string testInput = "00000000";
+		auto val = Internal::LoadEightChars(testInput.data());
+		EXPECT_TRUE(Internal::IsEightDigits(val));
+		EXPECT_EQ(Internal::EightDigitsToUInt(val), 0U);
+	}
+	{
+		std::string testInput = "99999999";
+		auto val = Internal::LoadEightChars(testInput.data());
+		EXPECT_TRUE(Internal::IsEightDigits(val));
+		EXPECT_EQ(Internal::EightDigitsToUInt(val), 99999999U);
+	}
+	{
+		std::string testInput = "00100200";
+		auto val = Internal::LoadEightChars(testInput.data());
+		EXPECT_TRUE(Internal::IsEightDigits(val));
+		EXPECT_EQ(Internal::EightDigitsToUInt(val), 100200U);
+	}
+
+	EXPECT_FALSE(Internal::IsEightDigits(
+		Internal::LoadEightChars("1234567.")));
+	EXPECT_FALSE(Internal::IsEightDigits(
+		Internal::LoadEightChars("/1234567")));
+	EXPECT_FALSE(Internal::IsEightDigits(
+		Internal::LoadEightChars("123:4567")));
+	EXPECT_FALSE(Internal::IsEightDigits(
+		Internal::LoadEightChars("1234567e")));
+	EXPECT_FALSE(Internal::IsEightDigits(
+		Internal::LoadEightChars("\xff\xff\xff\xff\xff\xff\xff\xff")));
+	EXPECT_FALSE(Internal::IsEightDigits(
+		Internal::LoadEightChars("\xb0\xb1\xb2\xb3\xb4\xb5\xb6\xb7")));
+}
+
+GTEST_TEST(TestRealNumParser, InternalIntStrToInt64)
+{
+	EXPECT_EQ(Internal::IntStrToInt64(std::string("0")), 0LL);
+	EXPECT_EQ(Internal::IntStrToInt64(std::string("-0")), 0LL);
+	EXPECT_EQ(Internal::IntStrToInt64(std::string("7")), 7LL);
+	EXPECT_EQ(Internal::IntStrToInt64(std::string("-7")), -7LL);
+	EXPECT_EQ(Internal::IntStrToInt64(std::string("12345678")), 12345678LL);
+	EXPECT_EQ(Internal::IntStrToInt64(std::string("123456789")), 123456789LL);
+	EXPECT_EQ(Internal::IntStrToInt64(std::string("-1234567890123456")),
+		-1234567890123456LL);
+	EXPECT_EQ(Internal::IntStrToInt64(std::string("1700000000123456789")),
+		1700000000123456789LL);
+	EXPECT_EQ(Internal::IntStrToInt64(std::string("9223372036854775807")),
+		std::numeric_limits<long long>::max());
+	EXPECT_EQ(Internal::IntStrToInt64(std::string("-9223372036854775808")),
+		std::numeric_limits<long long>::min());
+}
+
+GTEST_TEST(TestRealNumParser, InternalParseLongDigits)
+{
+	std::string res;
+
+	{
+		std::string testInput = "1234567890123456789,";
+		ForwardIteratorStateMachine<const char*> ism(
+			testInput.data(), testInput.data() + testInput.size());
+
+		res.clear();
+		EXPECT_NO_THROW(
+			Internal::ParseNumDigits(ism, std::back_inserter(res)););
+		EXPECT_EQ(res, "1234567890123456789");
+		EXPECT_EQ(ism.GetChar(), ',');
+		EXPECT_EQ(ism.GetColCount(), 19);
+	}
+	{
+		std::string testInput = "1234567890123456";
+		ForwardIteratorStateMachine<const char*> ism(
+			testInput.data(), testInput.data() + testInput.size());
+
+		res.clear();
+		EXPECT_NO_THROW(
+			Internal::ParseNumDigits(ism, std::back_inserter(res)););
+		EXPECT_EQ(res, "1234567890123456");
+		EXPECT_TRUE(ism.IsEnd());
+	}
+	{
+		std::string testInput = "12345678 9";
+		ForwardIteratorStateMachine<const char*> ism(
+			testInput.data(), testInput.data() + testInput.size());
+
+		res.clear();
+		EXPECT_NO_THROW(
+			Internal::ParseNumDigits(ism, std::back_inserter(res)););
+		EXPECT_EQ(res, "12345678");
+		EXPECT_EQ(ism.GetChar(), ' ');
+	}
+}
+
 // GenericNum
 
 GTEST_TEST(TestNullParser, GenericNumParseCorrect)
@@ -287,6 +386,40 @@ GTEST_TEST(TestNullParser, GenericNumParseCorrect)
 	}
 }
 
+GTEST_TEST(TestNullParser, GenericNumParseLongInt)
+{
+	using namespace Internal::Obj;
+
+	GenericNumberParser parser;
+	{
+		std::string testInput = " 1700000000123456789 ";
+		Object res;
+		EXPECT_NO_THROW(
+			res = parser.ParseTillEnd(testInput);
+		);
+		EXPECT_EQ(res, Object(Int64(1700000000123456789LL)));
+	}
+	{
+		std::string testInput = "[-9223372036854775808,9223372036854775807]";
+		List res;
+		EXPECT_NO_THROW(
+			res = ListParserT<GenericNumberParser>().ParseTillEnd(testInput);
+		);
+		EXPECT_EQ(res, List({
+			Object(Int64(std::numeric_limits<int64_t>::min())),
+			Object(Int64(std::numeric_limits<int64_t>::max())),
+		}));
+	}
+	{
+		std::string testInput = " 12345678901234567.125 ";
+		Object res;
+		EXPECT_NO_THROW(
+			res = parser.ParseTillEnd(testInput);
+		);
+		EXPECT_EQ(res, Object(Double(12345678901234567.125)));
+	}
+}
+
 GTEST_TEST(TestNullParser, GenericNumParseError)
 {
 	GenericNumberParser parser;
@@ -450,3 +583,184 @@ GTEST_TEST(TestNullParser, RealNumParseError)
 		);
 	}
 }
+
+// LazyNumberParse
+
+GTEST_TEST(TestRealNumParser, LazyNumberParseCorrect)
+{
+	LazyNumberParser parser;
+	{
+		std::string testInput = " \t 1700000000123456789   ";
+		LazyNumber res;
+		EXPECT_NO_THROW(
+			res = parser.ParseTillEnd(testInput);
+		);
+		EXPECT_TRUE(res.IsInteger());
+		EXPECT_EQ(res.GetRaw(), "1700000000123456789");
+		EXPECT_EQ(res.AsInt64(), 1700000000123456789LL);
+		EXPECT_EQ(res.AsDouble(), 1700000000123456789.0);
+	}
+	{
+		std::string testInput = " \r\n -12345.6789E-2;   ";
+		LazyNumber res;
+		EXPECT_NO_THROW(
+			res = parser.Parse(testInput);
+		);
+		EXPECT_FALSE(res.IsInteger());
+		EXPECT_EQ(res.GetRaw(), "-12345.6789E-2");
+		EXPECT_EQ(res.AsDouble(), -123.456789);
+		EXPECT_EQ(res.AsInt64(), -123LL);
+	}
+	{
+		std::string testInput = "[ 0.10000000000000000555, 1, -0 ]";
+		ListParserImpl<std::string, LazyNumberParser, std::vector<LazyNumber> >
+			listParser;
+		std::vector<LazyNumber> res;
+		EXPECT_NO_THROW(
+			res = listParser.ParseTillEnd(testInput);
+		);
+		ASSERT_EQ(res.size(), 3);
+		EXPECT_EQ(res[0], LazyNumber("0.10000000000000000555", false));
+		EXPECT_EQ(res[1], LazyNumber("1", true));
+		EXPECT_EQ(res[2], LazyNumber("-0", true));
+	}
+	// the text is kept as it is
+	{
+		for (const std::string testInput : { "1E+5", "-0.0E-0", "2e+10" })
+		{
+			LazyNumber res = parser.ParseTillEnd(testInput);
+			EXPECT_EQ(res.GetRaw(), testInput);
+		}
+		EXPECT_EQ(parser.ParseTillEnd("1E+5").AsDouble(), 1e5);
+		EXPECT_EQ(parser.ParseTillEnd("-0.0E-0").AsInt64(), 0);
+	}
+}
+
+GTEST_TEST(TestRealNumParser, LazyNumberParseError)
+{
+	LazyNumberParser parser;
+	{
+		std::string testInput = " \t -.123   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	{
+		std::string testInput = " \t 1.   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	{
+		std::string testInput = " \t 1e   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+}
+
+// DecimalParse
+
+GTEST_TEST(TestRealNumParser, DecimalParseCorrect)
+{
+	DecimalParser parser;
+	{
+		std::string testInput = " \t 19.90   ";
+		Decimal res;
+		EXPECT_NO_THROW(
+			res = parser.ParseTillEnd(testInput);
+		);
+		EXPECT_EQ(res, Decimal(false, 1990, -2));
+		EXPECT_TRUE(res.GetNotation().m_form == DecimalNotation::Form::Plain);
+	}
+	{
+		std::string testInput = " \r\n -0.000123456789012345E+3;   ";
+		Decimal res;
+		EXPECT_NO_THROW(
+			res = parser.Parse(testInput);
+		);
+		EXPECT_EQ(res, Decimal(true, 123456789012345ULL, -15));
+		EXPECT_TRUE(res.GetNotation().m_form == DecimalNotation::Form::Exp);
+		EXPECT_EQ(res.GetNotation().m_exp, 3);
+		EXPECT_EQ(res.GetNotation().m_expCh, 'E');
+		EXPECT_EQ(res.GetNotation().m_expSign, '+');
+		EXPECT_EQ(res.GetNotation().m_numExpDigits, 1);
+	}
+	{
+		std::string testInput = "18446744073709551615e-10";
+		Decimal res;
+		EXPECT_NO_THROW(
+			res = parser.ParseTillEnd(testInput);
+		);
+		EXPECT_EQ(res, Decimal(false, 18446744073709551615ULL, -10));
+	}
+	{
+		std::string testInput = "[ 0.10000000000000000555, 1, -0 ]";
+		ListParserImpl<std::string, DecimalParser, std::vector<Decimal> >
+			listParser;
+		std::vector<Decimal> res;
+		EXPECT_NO_THROW(
+			res = listParser.ParseTillEnd(testInput);
+		);
+		ASSERT_EQ(res.size(), 3);
+		EXPECT_EQ(res[0], Decimal(false, 10000000000000000555ULL, -20));
+		EXPECT_EQ(res[1], Decimal(false, 1, 0));
+		EXPECT_EQ(res[2], Decimal(true, 0, 0));
+	}
+#ifdef __SIZEOF_INT128__
+	{
+		std::string testInput = "123456789012345678901234567.89";
+		Decimal128 res;
+		EXPECT_NO_THROW(
+			res = Decimal128Parser().ParseTillEnd(testInput);
+		);
+		EXPECT_EQ(res.GetExp(), -2);
+		EXPECT_TRUE(res.GetCoef() ==
+			(Internal::UInt128(123456789012345678ULL) * 100000000000ULL) +
+				90123456789ULL);
+	}
+#endif // __SIZEOF_INT128__
+}
+
+GTEST_TEST(TestRealNumParser, DecimalParseError)
+{
+	DecimalParser parser;
+	{
+		std::string testInput = " \t -.123   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	{
+		std::string testInput = " \t 1.   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	{
+		std::string testInput = " \t 1e   ";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	{
+		std::string testInput = "18446744073709551616";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+	{
+		std::string testInput = "1e123456789";
+		EXPECT_THROW(
+			parser.Parse(testInput);,
+			ParseError
+		);
+	}
+}
@@ -3,6 +3,9 @@
 // license that can be found in the LICENSE file or at
 // https://opensource.org/licenses/MIT.
 
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <SimpleJson/SimpleJson.hpp>
@@ -310,4 +313,80 @@ GTEST_TEST(TestStaticDictParser, WriteStaticDict)
 		};
 		EXPECT_NO_THROW(testProg01(););
 	}
+
+	// the escaped keys are cached per type, and then reused by other
+	// objects of the same type, in both compact and pretty modes
+	{
+		TestStaticDict2ParserT<false, false> dict2Parser;
+		auto testProg02 = [&]()
+		{
+			auto dict01 = dict2Parser.ParseTillEnd(sk_testInput_01);
+			auto dict02 = dict2Parser.ParseTillEnd(sk_testInput_01s);
+
+			for (size_t i = 0; i < 2; ++i)
+			{
+				WriterConfig cfg;
+				std::string res;
+				JsonWriterObject::Write(
+					std::back_inserter(res),
+					(i == 0 ? dict01 : dict02),
+					cfg,
+					WriterStates()
+				);
+				EXPECT_EQ(res, sk_testInput_01s);
+
+				res = "";
+				cfg.m_indent = "\t";
+				JsonWriterObject::Write(
+					std::back_inserter(res),
+					(i == 0 ? dict02 : dict01),
+					cfg,
+					WriterStates()
+				);
+				EXPECT_EQ(res, sk_testInput_01);
+
+				res = "";
+				JsonWriterCompactObject::Write(
+					std::back_inserter(res),
+					dict01,
+					cfg,
+					WriterStates()
+				);
+				EXPECT_EQ(res, sk_testInput_01s);
+			}
+		};
+		EXPECT_NO_THROW(testProg02(););
+	}
+
+	// the cache is shared by all threads
+	{
+		TestStaticDict2ParserT<false, false> dict2Parser;
+		const auto dict01 = dict2Parser.ParseTillEnd(sk_testInput_01);
+
+		std::vector<std::string> results(8);
+		std::vector<std::thread> threads;
+		threads.reserve(results.size());
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			threads.emplace_back([&dict01, &results, i]()
+			{
+				WriterConfig cfg;
+				cfg.m_escapeUnicode = (i % 2 == 0);
+				JsonWriterCompactObject::Write(
+					std::back_inserter(results[i]),
+					dict01,
+					cfg,
+					WriterStates()
+				);
+			});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+		for (const auto& res : results)
+		{
+			EXPECT_EQ(res, sk_testInput_01s);
+		}
+	}
 }
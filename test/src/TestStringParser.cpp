@@ -3,6 +3,11 @@
 // license that can be found in the LICENSE file or at
 // https://opensource.org/licenses/MIT.
 
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <SimpleJson/SimpleJson.hpp>
@@ -201,3 +206,49 @@ GTEST_TEST(TestStringParser, ParseError)
 		);
 	}
 }
+
+GTEST_TEST(TestStringParser, BytesParser)
+{
+	auto toVec = [](const Internal::Obj::Bytes& b)
+	{
+		return std::vector<uint8_t>(b.data(), b.data() + b.size());
+	};
+	auto strToVec = [](const std::string& s)
+	{
+		return std::vector<uint8_t>(s.begin(), s.end());
+	};
+
+	// RFC 4648, Section 10
+	BytesParser base64Parser;
+	EXPECT_EQ(toVec(base64Parser.ParseTillEnd(" \"\" ")), strToVec(""));
+	EXPECT_EQ(toVec(base64Parser.ParseTillEnd("\"Zg==\"")), strToVec("f"));
+	EXPECT_EQ(toVec(base64Parser.ParseTillEnd("\"Zm8=\"")), strToVec("fo"));
+	EXPECT_EQ(toVec(base64Parser.ParseTillEnd("\"Zm9v\"")), strToVec("foo"));
+	EXPECT_EQ(
+		toVec(base64Parser.ParseTillEnd("\"Zm9vYg==\"")), strToVec("foob"));
+	EXPECT_EQ(
+		toVec(base64Parser.ParseTillEnd("\"Zm9vYmE=\"")), strToVec("fooba"));
+	EXPECT_EQ(
+		toVec(base64Parser.ParseTillEnd("\"Zm9vYmFy\"")), strToVec("foobar"));
+	EXPECT_EQ(
+		toVec(base64Parser.ParseTillEnd("\"+\\/+/\"")),
+		std::vector<uint8_t>({ 0xFBU, 0xFFU, 0xBFU }));
+
+	BytesParser hexParser(BytesEncoding::Hex);
+	EXPECT_EQ(toVec(hexParser.ParseTillEnd("\"\"")), strToVec(""));
+	EXPECT_EQ(
+		toVec(hexParser.ParseTillEnd("\"00fFA19b\"")),
+		std::vector<uint8_t>({ 0x00U, 0xFFU, 0xA1U, 0x9BU }));
+
+	for (const char* input : {
+		"Zg==", "\"Zg=\"", "\"Zg===\"", "\"Z===\"", "\"Zg\"", "\"=\"",
+		"\"Zg==Zg==\"", "\"Zm9v====\"", "\"Zm9\\u0076\"", "\"Zm 9v\"",
+		"\"Zm9v" })
+	{
+		EXPECT_THROW(base64Parser.ParseTillEnd(input);, ParseError);
+	}
+	for (const char* input : { "\"0\"", "\"0g\"", "\"000\"", "\"00" })
+	{
+		EXPECT_THROW(hexParser.ParseTillEnd(input);, ParseError);
+	}
+}